@@ -0,0 +1,668 @@
+/**
+ *
+ * @file DurableRedBlackTree.cpp
+ *
+ * @brief Durable red-black tree class implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the DurableRedBlackTree class. A checkpoint is a magic
+ *          string, the last sequence number it covers, the value count, the
+ *          sorted values and an FNV-1a checksum, in host byte order.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef DURABLE_RED_BLACK_TREE_CPP_
+#define DURABLE_RED_BLACK_TREE_CPP_
+#define DURABLE_CHECKPOINT_MAGIC "RBTCKPT1"
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <map>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include "DurableRedBlackTree.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Recovers the tree from the checkpoint and log in the configured
+ *          directory, opens the log and starts the compactor thread
+ *
+ * @param[in] config
+ *            Durability settings.
+ *
+ */
+template<typename T, typename A>
+DurableRedBlackTree<T, A>::DurableRedBlackTree(const DurabilityConfig& config)
+    : config_(config),
+      root_ptr_(std::make_shared< RedBlackNode< T, A > >(nullptr, false)),
+      log_ptr_(nullptr),
+      is_compaction_due_(false),
+      is_stopping_(false)
+{
+    // Rebuild.
+    auto last_lsn = recover();
+
+    // Open log.
+    log_ptr_ = std::make_shared< WriteAheadLog< T > >(
+        log_path(),
+        last_lsn,
+        config_.sync_every_ops,
+        config_.sync_every_us
+    );
+
+    // Start compactor.
+    compactor_ = std::thread(&DurableRedBlackTree<T, A>::run_compactor, this);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Stops the compactor thread and frees the tree; the log syncs when
+ *          released
+ *
+ */
+template<typename T, typename A>
+DurableRedBlackTree<T, A>::~DurableRedBlackTree()
+{
+    // Stop compactor.
+    {
+        std::lock_guard< std::mutex > lock(compactor_mutex_);
+        is_stopping_ = true;
+    }
+    compactor_cv_.notify_all();
+    compactor_.join();
+
+    // Free nodes (their parent links would keep them alive).
+    root_ptr_->clear();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a boolean value indicating if the tree is empty
+ *
+ * @return Boolean value indicating if the tree is empty
+ *
+ */
+template<typename T, typename A>
+bool DurableRedBlackTree<T, A>::empty() const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Forward.
+    return root_ptr_->empty();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Searches the tree for the value
+ *
+ * @param[in] key
+ *            Value used for comparison in search.
+ *
+ * @return Boolean value that represents the results of the search.
+ *
+ */
+template<typename T, typename A>
+bool DurableRedBlackTree<T, A>::contains(T key) const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Forward.
+    return root_ptr_->contains(key);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Iterates over the tree in order and executes the iteratee on each
+ *          item (with the tree locked).
+ *
+ * @param[in] iteratee
+ *            Function to execute with each item.
+ *
+ */
+template<typename T, typename A>
+void DurableRedBlackTree<T, A>::each_inorder(std::function< void(std::shared_ptr< T >) > iteratee)
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Forward.
+    root_ptr_->each_inorder(iteratee);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Logs the addition, then adds the item to the tree. The operation is
+ *          durable once the group commit covering it has synced; a failed
+ *          commit throws here and fails the log (later operations throw
+ *          before changing the tree).
+ *
+ * @param[in] key
+ *            Item to add to tree.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+template<typename T, typename A>
+bool DurableRedBlackTree<T, A>::add(const T& key)
+{
+    // Large log?
+    bool is_log_large;
+
+    // Apply.
+    {
+        // Lock.
+        std::lock_guard< std::mutex > lock(mutex_);
+
+        // Log first.
+        log_ptr_->append(WriteAheadLog< T >::ADD, key);
+
+        // Add item and update root.
+        root_ptr_->add(key);
+        root_ptr_ = root_ptr_->root();
+
+        // Check log.
+        is_log_large = log_ptr_->size() >= config_.compact_after_bytes;
+    }
+
+    // Group commit (outside the tree lock, so readers never wait on the disk).
+    log_ptr_->commit();
+
+    // Compact?
+    if (is_log_large)
+    {
+        // Wake compactor.
+        request_compaction();
+    }
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Logs the removal, then removes the item from the tree. Missing
+ *          items are not logged.
+ *
+ * @param[in] key
+ *            Item to remove from the tree.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+template<typename T, typename A>
+bool DurableRedBlackTree<T, A>::remove(const T& key)
+{
+    // Large log?
+    bool is_log_large;
+
+    // Apply.
+    {
+        // Lock.
+        std::lock_guard< std::mutex > lock(mutex_);
+
+        // Missing?
+        if (!root_ptr_->contains(key))
+        {
+            // Return failure.
+            return false;
+        }
+
+        // Log first.
+        log_ptr_->append(WriteAheadLog< T >::REMOVE, key);
+
+        // Remove item and update root.
+        root_ptr_->remove(key);
+        root_ptr_ = root_ptr_->root();
+
+        // Check log.
+        is_log_large = log_ptr_->size() >= config_.compact_after_bytes;
+    }
+
+    // Group commit (outside the tree lock, so readers never wait on the disk).
+    log_ptr_->commit();
+
+    // Compact?
+    if (is_log_large)
+    {
+        // Wake compactor.
+        request_compaction();
+    }
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Syncs every pending log record
+ *
+ */
+template<typename T, typename A>
+void DurableRedBlackTree<T, A>::sync()
+{
+    // Forward.
+    log_ptr_->sync();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Snapshots the tree and rotates the log under the tree lock (a
+ *          rename, no fsync), then syncs the rotated log, writes the
+ *          checkpoint and deletes the rotated log without blocking readers or
+ *          writers on the disk. If an earlier checkpoint failed after
+ *          rotating, the log is not rotated again (so the rotated records are
+ *          never overwritten before a checkpoint covers them).
+ *
+ */
+template<typename T, typename A>
+void DurableRedBlackTree<T, A>::checkpoint()
+{
+    // One checkpoint at a time.
+    std::lock_guard< std::mutex > checkpoint_lock(checkpoint_mutex_);
+
+    // Snapshot.
+    std::vector< T > values;
+    std::uint64_t lsn;
+    {
+        // Lock.
+        std::lock_guard< std::mutex > lock(mutex_);
+
+        // Copy values.
+        root_ptr_->each_inorder([&values] (std::shared_ptr< T > value_ptr) { values.push_back(*value_ptr); });
+
+        // Previous rotated log still pending?
+        if (::access(rotated_log_path().c_str(), F_OK) == 0)
+        {
+            // Keep both logs; the checkpoint covers them.
+            lsn = log_ptr_->last_lsn();
+        }
+        else
+        {
+            // Rotate.
+            lsn = log_ptr_->rotate(rotated_log_path());
+        }
+    }
+
+    // Complete the rotated log (outside the tree lock).
+    log_ptr_->sync();
+
+    // Persist (throws unless durable, keeping the rotated log).
+    write_checkpoint(values, lsn);
+
+    // Discard covered log.
+    std::remove(rotated_log_path().c_str());
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the path of the current log
+ *
+ * @return Log path
+ *
+ */
+template<typename T, typename A>
+std::string DurableRedBlackTree<T, A>::log_path() const
+{
+    // Build.
+    return config_.directory + "/wal.log";
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the path of a log waiting for its checkpoint
+ *
+ * @return Rotated log path
+ *
+ */
+template<typename T, typename A>
+std::string DurableRedBlackTree<T, A>::rotated_log_path() const
+{
+    // Build.
+    return config_.directory + "/wal.log.old";
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the path of the checkpoint
+ *
+ * @return Checkpoint path
+ *
+ */
+template<typename T, typename A>
+std::string DurableRedBlackTree<T, A>::checkpoint_path() const
+{
+    // Build.
+    return config_.directory + "/checkpoint";
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Loads the checkpoint, replays the rotated and current logs on top
+ *          of it and bulk-loads the result into the tree. If any record was
+ *          replayed, a new checkpoint is written before the logs are deleted,
+ *          so recovery never has to replay them again.
+ *
+ * @return Sequence number of the last recovered record
+ *
+ */
+template<typename T, typename A>
+std::uint64_t DurableRedBlackTree<T, A>::recover()
+{
+    // Load checkpoint.
+    std::vector< T > values;
+    auto checkpoint_lsn = read_checkpoint(values);
+
+    // Value multiplicities (the tree accepts duplicates).
+    std::map< T, std::size_t > counts;
+    for (const auto& value : values)
+    {
+        // Count.
+        ++counts[value];
+    }
+
+    // Record applier.
+    auto apply = [&counts] (typename WriteAheadLog< T >::Operation operation, const T& key)
+    {
+        // Add?
+        if (operation == WriteAheadLog< T >::ADD)
+        {
+            // Count.
+            ++counts[key];
+            return;
+        }
+
+        // Remove (if present).
+        auto count_it = counts.find(key);
+        if (count_it != counts.end() && --count_it->second == 0)
+        {
+            // Drop.
+            counts.erase(count_it);
+        }
+    };
+
+    // Replay logs, oldest first.
+    auto last_lsn = WriteAheadLog< T >::replay(rotated_log_path(), checkpoint_lsn, apply);
+    last_lsn = WriteAheadLog< T >::replay(log_path(), last_lsn, apply);
+
+    // Anything replayed?
+    if (last_lsn != checkpoint_lsn)
+    {
+        // Expand counts.
+        values.clear();
+        for (const auto& count : counts)
+        {
+            // Repeat.
+            values.insert(values.end(), count.second, count.first);
+        }
+
+        // Persist.
+        write_checkpoint(values, last_lsn);
+    }
+
+    // Discard covered logs.
+    std::remove(rotated_log_path().c_str());
+    std::remove(log_path().c_str());
+
+    // Bulk-load.
+    root_ptr_->assign_sorted(values);
+
+    // Return last sequence number.
+    return last_lsn;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Reads and validates the checkpoint
+ *
+ * @param[out] values
+ *             Sorted checkpoint values (empty without a checkpoint).
+ *
+ * @return Sequence number covered by the checkpoint (0 without one)
+ *
+ */
+template<typename T, typename A>
+std::uint64_t DurableRedBlackTree<T, A>::read_checkpoint(std::vector< T >& values) const
+{
+    // Open.
+    values.clear();
+    auto file_ptr = std::fopen(checkpoint_path().c_str(), "rb");
+
+    // Missing?
+    if (!file_ptr)
+    {
+        // Start empty.
+        return 0;
+    }
+
+    // Header.
+    char magic[sizeof(DURABLE_CHECKPOINT_MAGIC) - 1];
+    std::uint64_t lsn = 0;
+    std::uint64_t count = 0;
+    auto is_valid =
+        std::fread(magic, 1, sizeof(magic), file_ptr) == sizeof(magic) &&
+        std::memcmp(magic, DURABLE_CHECKPOINT_MAGIC, sizeof(magic)) == 0 &&
+        std::fread(&lsn, sizeof(lsn), 1, file_ptr) == 1 &&
+        std::fread(&count, sizeof(count), 1, file_ptr) == 1;
+
+    // Values and checksum.
+    std::uint32_t sum = 0;
+    if (is_valid)
+    {
+        // Read.
+        values.resize(count);
+        is_valid =
+            std::fread(values.data(), sizeof(T), count, file_ptr) == count &&
+            std::fread(&sum, sizeof(sum), 1, file_ptr) == 1;
+    }
+
+    // Close.
+    std::fclose(file_ptr);
+
+    // Verify checksum.
+    if (is_valid)
+    {
+        // Hash everything before the checksum.
+        auto hash = WriteAheadLog< T >::checksum(magic, sizeof(magic));
+        hash = WriteAheadLog< T >::checksum((const char*) &lsn, sizeof(lsn), hash);
+        hash = WriteAheadLog< T >::checksum((const char*) &count, sizeof(count), hash);
+        hash = WriteAheadLog< T >::checksum((const char*) values.data(), sizeof(T) * count, hash);
+        is_valid = hash == sum;
+    }
+
+    // Corrupt? (Checkpoints are renamed into place only after an fsync.)
+    if (!is_valid)
+    {
+        // Fail.
+        throw std::runtime_error("corrupt checkpoint " + checkpoint_path());
+    }
+
+    // Return sequence number.
+    return lsn;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Writes the checkpoint to a temporary file, fsyncs it and renames it
+ *          over the previous checkpoint, then fsyncs the directory. Throws if
+ *          any step fails, so callers delete logs only once the new checkpoint
+ *          is durable.
+ *
+ * @param[in] values
+ *            Sorted values to store.
+ *
+ * @param[in] lsn
+ *            Sequence number of the last operation reflected in the values.
+ *
+ */
+template<typename T, typename A>
+void DurableRedBlackTree<T, A>::write_checkpoint(const std::vector< T >& values, std::uint64_t lsn) const
+{
+    // Open temporary file.
+    auto temp_path = checkpoint_path() + ".tmp";
+    auto file_ptr = std::fopen(temp_path.c_str(), "wb");
+    if (!file_ptr)
+    {
+        // Fail.
+        throw std::system_error(errno, std::generic_category(), "open " + temp_path);
+    }
+
+    // Hash everything before the checksum.
+    std::uint64_t count = values.size();
+    auto hash = WriteAheadLog< T >::checksum(DURABLE_CHECKPOINT_MAGIC, sizeof(DURABLE_CHECKPOINT_MAGIC) - 1);
+    hash = WriteAheadLog< T >::checksum((const char*) &lsn, sizeof(lsn), hash);
+    hash = WriteAheadLog< T >::checksum((const char*) &count, sizeof(count), hash);
+    hash = WriteAheadLog< T >::checksum((const char*) values.data(), sizeof(T) * count, hash);
+
+    // Write and flush to disk.
+    auto is_written =
+        std::fwrite(DURABLE_CHECKPOINT_MAGIC, 1, sizeof(DURABLE_CHECKPOINT_MAGIC) - 1, file_ptr) == sizeof(DURABLE_CHECKPOINT_MAGIC) - 1 &&
+        std::fwrite(&lsn, sizeof(lsn), 1, file_ptr) == 1 &&
+        std::fwrite(&count, sizeof(count), 1, file_ptr) == 1 &&
+        std::fwrite(values.data(), sizeof(T), count, file_ptr) == count &&
+        std::fwrite(&hash, sizeof(hash), 1, file_ptr) == 1 &&
+        std::fflush(file_ptr) == 0 &&
+        ::fsync(fileno(file_ptr)) == 0;
+    auto error = errno;
+    std::fclose(file_ptr);
+
+    // Failed?
+    if (!is_written)
+    {
+        // Fail.
+        throw std::system_error(error, std::generic_category(), "write " + temp_path);
+    }
+
+    // Replace checkpoint.
+    if (std::rename(temp_path.c_str(), checkpoint_path().c_str()) != 0)
+    {
+        // Fail.
+        throw std::system_error(errno, std::generic_category(), "rename " + temp_path);
+    }
+
+    // Make rename durable.
+    auto directory_fd = ::open(config_.directory.c_str(), O_RDONLY);
+    if (directory_fd < 0)
+    {
+        // Fail.
+        throw std::system_error(errno, std::generic_category(), "open " + config_.directory);
+    }
+
+    // Flush directory entry.
+    auto is_synced = ::fsync(directory_fd) == 0;
+    auto sync_error = errno;
+    ::close(directory_fd);
+    if (!is_synced)
+    {
+        // Fail (callers keep the logs the checkpoint would cover).
+        throw std::system_error(sync_error, std::generic_category(), "fsync " + config_.directory);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Flags the log as large and wakes the compactor thread
+ *
+ */
+template<typename T, typename A>
+void DurableRedBlackTree<T, A>::request_compaction()
+{
+    // Flag.
+    {
+        std::lock_guard< std::mutex > lock(compactor_mutex_);
+        is_compaction_due_ = true;
+    }
+
+    // Wake.
+    compactor_cv_.notify_one();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Waits for compaction requests and checkpoints while the log is
+ *          still large
+ *
+ */
+template<typename T, typename A>
+void DurableRedBlackTree<T, A>::run_compactor()
+{
+    // Lock.
+    std::unique_lock< std::mutex > lock(compactor_mutex_);
+
+    // Run until stopped.
+    while (true)
+    {
+        // Wait for work.
+        compactor_cv_.wait(lock, [this] { return is_compaction_due_ || is_stopping_; });
+
+        // Stopped?
+        if (is_stopping_)
+        {
+            // Exit.
+            return;
+        }
+
+        // Clear flag and compact without holding the lock.
+        is_compaction_due_ = false;
+        lock.unlock();
+        if (log_ptr_->size() >= config_.compact_after_bytes)
+        {
+            // Compact (a failure leaves the log in place; retried on the next request).
+            try
+            {
+                checkpoint();
+            }
+            catch (const std::exception&) {}
+        }
+        lock.lock();
+    }
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#undef DURABLE_CHECKPOINT_MAGIC
+#endif // DURABLE_RED_BLACK_TREE_CPP_
+//
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ *
+ * @file DurableRedBlackTree.h
+ *
+ * @brief Durable red-black tree class definition.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the DurableRedBlackTree class, which owns a red-black tree
+ *          and logs every successful add/remove to a write-ahead log. On
+ *          construction the tree is recovered from the latest checkpoint plus
+ *          the log; a background thread compacts the log into a new
+ *          checkpoint once it grows past a threshold.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef DURABLE_RED_BLACK_TREE_H_
+#define DURABLE_RED_BLACK_TREE_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+#include "../RedBlackNode/RedBlackNode.h"
+#include "../WriteAheadLog/WriteAheadLog.h"
+//
+//  Class Definitions  /////////////////////////////////////////////////////////
+//
+struct DurabilityConfig
+{
+    std::string directory; /**< Directory holding the log and checkpoint (must exist) */
+    unsigned int sync_every_ops = 64; /**< Group commit: fsync once this many operations are pending (0 disables) */
+    unsigned int sync_every_us = 1000; /**< Group commit: fsync once the oldest pending operation is this old (0 disables) */
+    std::uint64_t compact_after_bytes = 64 << 20; /**< Compact the log into a checkpoint once it reaches this size */
+};
+
+template<class T, class A = NoAugment< T > >
+class DurableRedBlackTree
+{
+// Public members.
+public:
+    DurableRedBlackTree(const DurabilityConfig&); /**< Recovers the tree from the directory */
+    DurableRedBlackTree(const DurableRedBlackTree<T, A>&) = delete; /**< Not copyable (owns files and threads) */
+    ~DurableRedBlackTree(); /**< Destructor (syncs the log and frees the tree) */
+
+    bool empty() const; /**< Returns boolean indicating whether the tree is empty */
+    bool contains(T) const; /**< Check if the value exists in the tree */
+    void each_inorder(std::function< void(std::shared_ptr<T>) >); /**< Executes provided function on each item in-order. */
+    bool add(const T&); /**< Adds and logs item and returns boolean value indicating success */
+    bool remove(const T&); /**< Removes and logs item and returns boolean value indicating success */
+    void sync(); /**< Makes every logged operation durable */
+    void checkpoint(); /**< Writes a checkpoint and discards the log it covers */
+
+// Private members.
+private:
+    DurabilityConfig config_; /**< Durability settings */
+    std::shared_ptr< RedBlackNode< T, A > > root_ptr_; /**< Smart pointer to the root of the tree */
+    std::shared_ptr< WriteAheadLog< T > > log_ptr_; /**< Smart pointer to the write-ahead log */
+    mutable std::mutex mutex_; /**< Guards the tree (and orders log records like the tree operations) */
+    std::mutex checkpoint_mutex_; /**< Serializes checkpoints */
+    std::mutex compactor_mutex_; /**< Guards the compactor flag */
+    std::condition_variable compactor_cv_; /**< Wakes the compactor thread */
+    bool is_compaction_due_; /**< Boolean value telling the compactor thread the log is large */
+    bool is_stopping_; /**< Boolean value telling the compactor thread to exit */
+    std::thread compactor_; /**< Background compaction thread */
+
+    std::string log_path() const; /**< Returns the path of the current log */
+    std::string rotated_log_path() const; /**< Returns the path of a log being compacted */
+    std::string checkpoint_path() const; /**< Returns the path of the checkpoint */
+    std::uint64_t recover(); /**< Rebuilds the tree from disk and returns the last sequence number */
+    std::uint64_t read_checkpoint(std::vector< T >&) const; /**< Loads the checkpoint values and returns its sequence number */
+    void write_checkpoint(const std::vector< T >&, std::uint64_t) const; /**< Durably replaces the checkpoint */
+    void request_compaction(); /**< Wakes the compactor thread */
+    void run_compactor(); /**< Compactor thread body */
+};
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "DurableRedBlackTree.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // DURABLE_RED_BLACK_TREE_H_
+//
\ No newline at end of file
@@ -0,0 +1,310 @@
+/**
+ *
+ * @file HashIndex.cpp
+ *
+ * @brief Open-addressing hash index class implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the HashIndex class. Hashes are mixed with a Fibonacci
+ *          multiplier before indexing, since std::hash is the identity for
+ *          integers and linear probing clusters badly on patterned keys.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef HASH_INDEX_CPP_
+#define HASH_INDEX_CPP_
+#define HASH_INDEX_INITIAL_BITS 4
+#define HASH_INDEX_MIX 0x9E3779B97F4A7C15ull
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include "HashIndex.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Default initializes an empty index with a small slot array
+ *
+ */
+template<typename T, typename H>
+HashIndex<T, H>::HashIndex()
+    : slots_((std::size_t) 1 << HASH_INDEX_INITIAL_BITS, Slot{ T(), 0 }),
+      size_(0),
+      shift_(64 - HASH_INDEX_INITIAL_BITS),
+      hasher_() {}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the number of distinct keys
+ *
+ * @return Number of distinct keys
+ *
+ */
+template<typename T, typename H>
+std::size_t HashIndex<T, H>::size() const
+{
+    // Return size.
+    return size_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the bytes used by the slot array
+ *
+ * @return Slot array size in bytes
+ *
+ */
+template<typename T, typename H>
+std::size_t HashIndex<T, H>::memory() const
+{
+    // Return size.
+    return slots_.capacity() * sizeof(Slot);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a boolean value indicating whether the key is present
+ *
+ * @param[in] key
+ *            Key to look up.
+ *
+ * @return Boolean value indicating whether the key is present
+ *
+ */
+template<typename T, typename H>
+bool HashIndex<T, H>::contains(const T& key) const
+{
+    // Occupied slot found?
+    return slots_[find(key)].count != 0;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the multiplicity of the key
+ *
+ * @param[in] key
+ *            Key to look up.
+ *
+ * @return Multiplicity (0 when absent)
+ *
+ */
+template<typename T, typename H>
+std::size_t HashIndex<T, H>::count(const T& key) const
+{
+    // Return count of slot.
+    return slots_[find(key)].count;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Increments the multiplicity of the key, claiming a slot if it is
+ *          absent. Grows first when the load factor would exceed 0.7, so a
+ *          failed allocation leaves the index unchanged.
+ *
+ * @param[in] key
+ *            Key to insert.
+ *
+ */
+template<typename T, typename H>
+void HashIndex<T, H>::insert(const T& key)
+{
+    // Find slot.
+    auto index = find(key);
+
+    // Present?
+    if (slots_[index].count)
+    {
+        // Count.
+        ++slots_[index].count;
+        return;
+    }
+
+    // Too full?
+    if ((size_ + 1) * 10 > slots_.size() * 7)
+    {
+        // Grow and find new slot.
+        grow();
+        index = find(key);
+    }
+
+    // Claim slot.
+    slots_[index] = Slot{ key, 1 };
+    ++size_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Decrements the multiplicity of the key. When it reaches zero, later
+ *          entries of the probe run are shifted back into the hole (unless
+ *          already at or before their preferred slot).
+ *
+ * @param[in] key
+ *            Key to erase.
+ *
+ * @return Boolean value indicating whether the key was present
+ *
+ */
+template<typename T, typename H>
+bool HashIndex<T, H>::erase(const T& key)
+{
+    // Find slot.
+    auto hole = find(key);
+
+    // Absent?
+    if (!slots_[hole].count)
+    {
+        // Return failure.
+        return false;
+    }
+
+    // Still present?
+    if (--slots_[hole].count)
+    {
+        // Return success.
+        return true;
+    }
+
+    // Close the hole.
+    auto mask = slots_.size() - 1;
+    for (auto index = (hole + 1) & mask; slots_[index].count; index = (index + 1) & mask)
+    {
+        // Distance from preferred slot to the entry and to the hole.
+        auto preferred = home(slots_[index].key);
+        auto entry_distance = (index - preferred) & mask;
+        auto hole_distance = (hole - preferred) & mask;
+
+        // Hole on the entry's probe path?
+        if (hole_distance < entry_distance)
+        {
+            // Shift back.
+            slots_[hole] = slots_[index];
+            hole = index;
+        }
+    }
+
+    // Empty final hole.
+    slots_[hole].count = 0;
+    --size_;
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Removes every key (keeping the slot array)
+ *
+ */
+template<typename T, typename H>
+void HashIndex<T, H>::clear()
+{
+    // Empty slots.
+    for (auto& slot : slots_)
+    {
+        // Reset.
+        slot.count = 0;
+    }
+
+    // Reset size.
+    size_ = 0;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the preferred slot of the key (top bits of the mixed hash)
+ *
+ * @param[in] key
+ *            Key to place.
+ *
+ * @return Slot index
+ *
+ */
+template<typename T, typename H>
+std::size_t HashIndex<T, H>::home(const T& key) const
+{
+    // Mix and take top bits.
+    return (std::size_t) (((std::uint64_t) hasher_(key) * HASH_INDEX_MIX) >> shift_);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Probes linearly from the preferred slot until the key or an empty
+ *          slot is found (the load factor guarantees an empty slot exists)
+ *
+ * @param[in] key
+ *            Key to look up.
+ *
+ * @return Index of the matching or terminating empty slot
+ *
+ */
+template<typename T, typename H>
+std::size_t HashIndex<T, H>::find(const T& key) const
+{
+    // Probe.
+    auto mask = slots_.size() - 1;
+    auto index = home(key);
+    while (slots_[index].count && !(slots_[index].key == key))
+    {
+        // Advance.
+        index = (index + 1) & mask;
+    }
+
+    // Return slot.
+    return index;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Doubles the slot array and re-inserts every occupied slot
+ *
+ */
+template<typename T, typename H>
+void HashIndex<T, H>::grow()
+{
+    // Allocate new array.
+    std::vector< Slot > old_slots(slots_.size() * 2, Slot{ T(), 0 });
+    old_slots.swap(slots_);
+    --shift_;
+
+    // Re-insert.
+    for (const auto& slot : old_slots)
+    {
+        // Occupied?
+        if (slot.count)
+        {
+            // Place.
+            slots_[find(slot.key)] = slot;
+        }
+    }
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#undef HASH_INDEX_INITIAL_BITS
+#undef HASH_INDEX_MIX
+#endif // HASH_INDEX_CPP_
+//
\ No newline at end of file
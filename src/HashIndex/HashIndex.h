@@ -0,0 +1,70 @@
+/**
+ *
+ * @file HashIndex.h
+ *
+ * @brief Open-addressing hash index class definition.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the HashIndex class, a linear-probing hash table mapping
+ *          each key to its multiplicity. Slots are a flat array (no per-key
+ *          allocation) and removals shift later entries back instead of
+ *          leaving tombstones, so probe sequences stay short.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef HASH_INDEX_H_
+#define HASH_INDEX_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+//
+//  Class Definition  //////////////////////////////////////////////////////////
+//
+template<class T, class H = std::hash< T > >
+class HashIndex
+{
+// Public members.
+public:
+    HashIndex(); /**< Default constructor */
+
+    std::size_t size() const; /**< Returns the number of distinct keys */
+    std::size_t memory() const; /**< Returns the bytes used by the slot array */
+    bool contains(const T&) const; /**< Returns boolean indicating whether the key is present */
+    std::size_t count(const T&) const; /**< Returns the multiplicity of the key */
+    void insert(const T&); /**< Increments the multiplicity of the key */
+    bool erase(const T&); /**< Decrements the multiplicity of the key and returns boolean value indicating success */
+    void clear(); /**< Removes every key */
+
+// Private members.
+private:
+    struct Slot
+    {
+        T key; /**< Stored key */
+        std::uint32_t count; /**< Multiplicity (0 marks an empty slot) */
+    };
+
+    std::vector< Slot > slots_; /**< Slot array (power-of-two length) */
+    std::size_t size_; /**< Number of occupied slots */
+    unsigned int shift_; /**< Right shift turning a mixed hash into a slot index */
+    H hasher_; /**< Key hash function */
+
+    std::size_t home(const T&) const; /**< Returns the preferred slot of the key */
+    std::size_t find(const T&) const; /**< Returns the slot holding the key, or the empty slot ending its probe */
+    void grow(); /**< Doubles the slot array and re-inserts every key */
+};
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "HashIndex.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // HASH_INDEX_H_
+//
\ No newline at end of file
@@ -0,0 +1,268 @@
+/**
+ *
+ * @file IndexedRedBlackTree.cpp
+ *
+ * @brief Hash-indexed red-black tree class implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the IndexedRedBlackTree class. Every mutation updates
+ *          the index and the tree in the same call, ordered so that the step
+ *          that may allocate (and throw) runs before anything is changed that
+ *          it cannot undo.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef INDEXED_RED_BLACK_TREE_CPP_
+#define INDEXED_RED_BLACK_TREE_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include "IndexedRedBlackTree.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Default initializes an empty tree and index
+ *
+ */
+template<typename T, typename A, typename H>
+IndexedRedBlackTree<T, A, H>::IndexedRedBlackTree()
+    : root_ptr_(std::make_shared< RedBlackNode< T, A > >(nullptr, false)),
+      index_() {}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Frees the tree (its nodes link to each other, so they are not
+ *          released with the root pointer alone)
+ *
+ */
+template<typename T, typename A, typename H>
+IndexedRedBlackTree<T, A, H>::~IndexedRedBlackTree()
+{
+    // Free nodes.
+    root_ptr_->clear();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a boolean value indicating if the tree is empty
+ *
+ * @return Boolean value indicating if the tree is empty
+ *
+ */
+template<typename T, typename A, typename H>
+bool IndexedRedBlackTree<T, A, H>::empty() const
+{
+    // No keys indexed.
+    return index_.size() == 0;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Looks the value up in the hash index
+ *
+ * @param[in] key
+ *            Value to look up.
+ *
+ * @return Boolean value that represents the results of the search.
+ *
+ */
+template<typename T, typename A, typename H>
+bool IndexedRedBlackTree<T, A, H>::contains(const T& key) const
+{
+    // Probe index.
+    return index_.contains(key);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the number of copies of the value from the hash index
+ *
+ * @param[in] key
+ *            Value to look up.
+ *
+ * @return Number of copies in the tree
+ *
+ */
+template<typename T, typename A, typename H>
+std::size_t IndexedRedBlackTree<T, A, H>::count(const T& key) const
+{
+    // Probe index.
+    return index_.count(key);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the bytes used by the hash index (on top of the tree)
+ *
+ * @return Index size in bytes
+ *
+ */
+template<typename T, typename A, typename H>
+std::size_t IndexedRedBlackTree<T, A, H>::index_memory() const
+{
+    // Forward.
+    return index_.memory();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a read-only smart pointer to the root node for ordered
+ *          queries. The child getters of a node still return mutable nodes;
+ *          changing the tree through them would bypass the index and is not
+ *          supported.
+ *
+ * @return Read-only smart pointer to the root node
+ *
+ */
+template<typename T, typename A, typename H>
+std::shared_ptr< const RedBlackNode< T, A > > IndexedRedBlackTree<T, A, H>::root() const
+{
+    // Return root.
+    return root_ptr_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of every value in the inclusive range
+ *
+ * @param[in] lower
+ *            Inclusive lower bound of the range.
+ *
+ * @param[in] upper
+ *            Inclusive upper bound of the range.
+ *
+ * @return Summary of the values in the range
+ *
+ */
+template<typename T, typename A, typename H>
+typename A::summary_type IndexedRedBlackTree<T, A, H>::aggregate(const T& lower, const T& upper) const
+{
+    // Forward.
+    return root_ptr_->aggregate(lower, upper);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Iterates over the tree in order and executes the iteratee on each
+ *          item.
+ *
+ * @param[in] iteratee
+ *            Function to execute with each item.
+ *
+ */
+template<typename T, typename A, typename H>
+void IndexedRedBlackTree<T, A, H>::each_inorder(std::function< void(std::shared_ptr< T >) > iteratee)
+{
+    // Forward.
+    root_ptr_->each_inorder(iteratee);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Indexes the item (which may grow the index), then adds it to the
+ *          tree
+ *
+ * @param[in] key
+ *            Item to add.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+template<typename T, typename A, typename H>
+bool IndexedRedBlackTree<T, A, H>::add(const T& key)
+{
+    // Index.
+    index_.insert(key);
+
+    // Add to tree (undoing the index entry on failure).
+    try
+    {
+        root_ptr_->add(key);
+    }
+    catch (...)
+    {
+        // Undo and rethrow.
+        index_.erase(key);
+        throw;
+    }
+
+    // Update root.
+    root_ptr_ = root_ptr_->root();
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Removes the item from the index, then from the tree. Missing items
+ *          are rejected by the index without touching the tree.
+ *
+ * @param[in] key
+ *            Item to remove.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+template<typename T, typename A, typename H>
+bool IndexedRedBlackTree<T, A, H>::remove(const T& key)
+{
+    // Missing?
+    if (!index_.erase(key))
+    {
+        // Return failure.
+        return false;
+    }
+
+    // Remove from tree and update root.
+    root_ptr_->remove(key);
+    root_ptr_ = root_ptr_->root();
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Clears the tree and the index
+ *
+ */
+template<typename T, typename A, typename H>
+void IndexedRedBlackTree<T, A, H>::clear()
+{
+    // Clear both.
+    root_ptr_->clear();
+    index_.clear();
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // INDEXED_RED_BLACK_TREE_CPP_
+//
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ *
+ * @file IndexedRedBlackTree.h
+ *
+ * @brief Hash-indexed red-black tree class definition.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the IndexedRedBlackTree class, an opt-in mode that keeps a
+ *          HashIndex of the stored keys alongside a red-black tree. Point
+ *          membership is answered by the index in O(1); ordered traversal and
+ *          range aggregates use the tree. All changes must go through add,
+ *          remove and clear: the tree is exposed only as a const root, since
+ *          changing it directly would leave the index out of sync.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef INDEXED_RED_BLACK_TREE_H_
+#define INDEXED_RED_BLACK_TREE_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <memory>
+#include <functional>
+#include <cstddef>
+#include "../RedBlackNode/RedBlackNode.h"
+#include "../HashIndex/HashIndex.h"
+//
+//  Class Definition  //////////////////////////////////////////////////////////
+//
+template<class T, class A = NoAugment< T >, class H = std::hash< T > >
+class IndexedRedBlackTree
+{
+// Public members.
+public:
+    IndexedRedBlackTree(); /**< Default constructor */
+    IndexedRedBlackTree(const IndexedRedBlackTree<T, A, H>&) = delete; /**< Not copyable (copies would share the tree) */
+    ~IndexedRedBlackTree(); /**< Destructor (frees the tree) */
+
+    bool empty() const; /**< Returns boolean indicating whether the tree is empty */
+    bool contains(const T&) const; /**< Check if the value exists (hash index, O(1)) */
+    std::size_t count(const T&) const; /**< Returns the number of copies of the value (hash index, O(1)) */
+    std::size_t index_memory() const; /**< Returns the bytes used by the hash index */
+    std::shared_ptr< const RedBlackNode< T, A > > root() const; /**< Returns read-only smart pointer to the root for ordered operations */
+    typename A::summary_type aggregate(const T&, const T&) const; /**< Returns the summary of all values in the inclusive range */
+    void each_inorder(std::function< void(std::shared_ptr<T>) >); /**< Executes provided function on each item in-order. */
+    bool add(const T&); /**< Adds item to the tree and index and returns boolean value indicating success */
+    bool remove(const T&); /**< Removes item from the tree and index and returns boolean value indicating success */
+    void clear(); /**< Removes every item */
+
+// Private members.
+private:
+    std::shared_ptr< RedBlackNode< T, A > > root_ptr_; /**< Smart pointer to the root of the tree */
+    HashIndex< T, H > index_; /**< Key multiplicities */
+};
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "IndexedRedBlackTree.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // INDEXED_RED_BLACK_TREE_H_
+//
\ No newline at end of file
@@ -0,0 +1,504 @@
+/**
+ *
+ * @file IntervalTree.cpp
+ *
+ * @brief Interval tree implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the Interval value type, the maximum endpoint policy and
+ *          the overlap queries.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef INTERVAL_TREE_CPP_
+#define INTERVAL_TREE_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include "IntervalTree.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a boolean value indicating whether both closed intervals
+ *          share at least one point
+ *
+ * @param[in] other
+ *            Interval to test against.
+ *
+ * @return Boolean value indicating whether the intervals overlap
+ *
+ */
+template<typename T>
+bool Interval<T>::overlaps(const Interval<T>& other) const
+{
+    // Neither ends before the other starts.
+    return low <= other.high && other.low <= high;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @details Compares two intervals for equality
+ *
+ * @return Boolean value indicating whether start and end are equal
+ *
+ */
+template<typename T>
+bool operator==(const Interval<T>& lhs, const Interval<T>& rhs)
+{
+    // Compare both endpoints.
+    return lhs.low == rhs.low && lhs.high == rhs.high;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @details Orders intervals by start, breaking ties by end
+ *
+ * @return Boolean value indicating whether lhs orders before rhs
+ *
+ */
+template<typename T>
+bool operator<(const Interval<T>& lhs, const Interval<T>& rhs)
+{
+    // Start first, then end.
+    return lhs.low < rhs.low || (lhs.low == rhs.low && lhs.high < rhs.high);
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @details Orders intervals by start, breaking ties by end
+ *
+ * @return Boolean value indicating whether lhs does not order after rhs
+ *
+ */
+template<typename T>
+bool operator<=(const Interval<T>& lhs, const Interval<T>& rhs)
+{
+    // Not after.
+    return !(rhs < lhs);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the smallest representable value (summary of an empty
+ *          sub-tree)
+ *
+ * @return The smallest representable value
+ *
+ */
+template<typename T>
+typename MaxEndpointAugment<T>::summary_type MaxEndpointAugment<T>::identity()
+{
+    // Bound.
+    return std::numeric_limits< T >::lowest();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the endpoint of a single interval
+ *
+ * @param[in] value
+ *            Interval to lift
+ *
+ * @return The interval end
+ *
+ */
+template<typename T>
+typename MaxEndpointAugment<T>::summary_type MaxEndpointAugment<T>::lift(const Interval<T>& value)
+{
+    // End.
+    return value.high;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the largest endpoint of two adjacent sub-trees
+ *
+ * @param[in] lhs
+ *            Endpoint of the left sub-tree
+ *
+ * @param[in] rhs
+ *            Endpoint of the right sub-tree
+ *
+ * @return Larger endpoint
+ *
+ */
+template<typename T>
+typename MaxEndpointAugment<T>::summary_type MaxEndpointAugment<T>::combine(
+    const summary_type& lhs,
+    const summary_type& rhs
+)
+{
+    // Compare.
+    return std::max(lhs, rhs);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Default initializes an exhausted (end) iterator
+ *
+ */
+template<typename T>
+IntervalOverlapIterator<T>::IntervalOverlapIterator()
+    : query_(),
+      stack_(),
+      current_ptr_(nullptr),
+      current_() {}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Initializes the iterator on the first stored interval (in order)
+ *          overlapping the query
+ *
+ * @param[in] root_ptr
+ *            Root of the tree to search.
+ *
+ * @param[in] query
+ *            Interval being matched.
+ *
+ */
+template<typename T>
+IntervalOverlapIterator<T>::IntervalOverlapIterator(
+    std::shared_ptr< IntervalNode< T > > root_ptr,
+    const Interval< T >& query
+)
+    : query_(query),
+      stack_(),
+      current_ptr_(nullptr),
+      current_()
+{
+    // Stack first candidates.
+    push_left(root_ptr);
+
+    // Find first overlap.
+    advance();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the current interval
+ *
+ * @return Reference to the current interval
+ *
+ */
+template<typename T>
+typename IntervalOverlapIterator<T>::reference IntervalOverlapIterator<T>::operator*() const
+{
+    // Return current.
+    return current_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a pointer to the current interval
+ *
+ * @return Pointer to the current interval
+ *
+ */
+template<typename T>
+typename IntervalOverlapIterator<T>::pointer IntervalOverlapIterator<T>::operator->() const
+{
+    // Return current.
+    return &current_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Advances to the next overlapping interval
+ *
+ * @return Reference to this iterator
+ *
+ */
+template<typename T>
+IntervalOverlapIterator<T>& IntervalOverlapIterator<T>::operator++()
+{
+    // Advance.
+    advance();
+
+    // Return this.
+    return *this;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Compares two iterators
+ *
+ * @return Boolean value indicating whether both point to the same node
+ *
+ */
+template<typename T>
+bool IntervalOverlapIterator<T>::operator==(const IntervalOverlapIterator<T>& other) const
+{
+    // Same position (end iterators hold nullptr).
+    return current_ptr_ == other.current_ptr_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Compares two iterators
+ *
+ * @return Boolean value indicating whether they point to different nodes
+ *
+ */
+template<typename T>
+bool IntervalOverlapIterator<T>::operator!=(const IntervalOverlapIterator<T>& other) const
+{
+    // Negate.
+    return !(*this == other);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Stacks the node and its left descendants, stopping at the first
+ *          sub-tree whose largest endpoint ends before the query starts (no
+ *          interval below it can overlap).
+ *
+ * @param[in] node_ptr
+ *            Root of the sub-tree to descend.
+ *
+ */
+template<typename T>
+void IntervalOverlapIterator<T>::push_left(std::shared_ptr< IntervalNode< T > > node_ptr)
+{
+    // Descend while an overlap is still possible.
+    while (!node_ptr->empty() && !(node_ptr->summary() < query_.low))
+    {
+        // Stack.
+        stack_.push_back(node_ptr);
+
+        // Advance.
+        node_ptr = node_ptr->left_child();
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Pops candidates in order until one overlaps the query. Stops as
+ *          soon as a candidate starts after the query ends, since every later
+ *          interval starts no earlier.
+ *
+ */
+template<typename T>
+void IntervalOverlapIterator<T>::advance()
+{
+    // Drain candidates.
+    while (!stack_.empty())
+    {
+        // Pop.
+        auto node_ptr = stack_.back();
+        stack_.pop_back();
+
+        // Get value.
+        auto value = node_ptr->value();
+
+        // Past the query?
+        if (query_.high < value.low)
+        {
+            // Nothing further can overlap.
+            stack_.clear();
+
+            // Done.
+            break;
+        }
+
+        // Stack right sub-tree.
+        push_left(node_ptr->right_child());
+
+        // Overlap?
+        if (value.overlaps(query_))
+        {
+            // Update.
+            current_ptr_ = node_ptr;
+            current_ = value;
+
+            // Found.
+            return;
+        }
+    }
+
+    // Exhausted.
+    current_ptr_ = nullptr;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Initializes the range over the tree and query
+ *
+ * @param[in] root_ptr
+ *            Root of the tree to search.
+ *
+ * @param[in] query
+ *            Interval being matched.
+ *
+ */
+template<typename T>
+IntervalOverlapRange<T>::IntervalOverlapRange(
+    std::shared_ptr< IntervalNode< T > > root_ptr,
+    const Interval< T >& query
+)
+    : root_ptr_(root_ptr),
+      query_(query) {}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Starts the enumeration
+ *
+ * @return Iterator on the first overlap
+ *
+ */
+template<typename T>
+IntervalOverlapIterator<T> IntervalOverlapRange<T>::begin() const
+{
+    // Start.
+    return IntervalOverlapIterator<T>(root_ptr_, query_);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the end of the enumeration
+ *
+ * @return End iterator
+ *
+ */
+template<typename T>
+IntervalOverlapIterator<T> IntervalOverlapRange<T>::end() const
+{
+    // End.
+    return IntervalOverlapIterator<T>();
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Enumerates stored intervals overlapping the query
+ *
+ * @details Returns a lazy range; each step resumes the pruned in-order walk,
+ *          skipping sub-trees whose largest endpoint ends before the query
+ *          and stopping at the first interval starting after it. The whole
+ *          enumeration of k overlaps takes O(min(n, (k + 1) log n)), not
+ *          O(log n + k): the tree is ordered by start only, so the overlaps
+ *          can lie in k separate sub-trees that each take their own descent.
+ *          Each step takes O(log n) amortized over a full enumeration.
+ *
+ * @param[in] root_ptr
+ *            Root of the tree to search.
+ *
+ * @param[in] query
+ *            Interval being matched.
+ *
+ * @return Range of overlapping intervals, in order
+ *
+ */
+template<typename T>
+IntervalOverlapRange<T> interval_tree::overlapping(
+  std::shared_ptr< IntervalNode< T > > root_ptr,
+  const Interval< T >& query
+)
+{
+  // Build range.
+  return IntervalOverlapRange<T>(root_ptr, query);
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Tests whether any stored interval overlaps the query
+ *
+ * @details Follows a single root-to-leaf path: go left whenever the left
+ *          sub-tree reaches the query start (if it holds no overlap, neither
+ *          does the right sub-tree), otherwise go right.
+ *
+ * @param[in] root_ptr
+ *            Root of the tree to search.
+ *
+ * @param[in] query
+ *            Interval being matched.
+ *
+ * @return Boolean value indicating whether an overlap exists
+ *
+ */
+template<typename T>
+bool interval_tree::any_overlap(
+  std::shared_ptr< IntervalNode< T > > root_ptr,
+  const Interval< T >& query
+)
+{
+  // Cursor.
+  auto node_ptr = root_ptr;
+
+  // Descend.
+  while (!node_ptr->empty())
+  {
+    // Overlap?
+    if (node_ptr->value().overlaps(query))
+    {
+      // Found.
+      return true;
+    }
+
+    // Get left sub-tree.
+    auto left_ptr = node_ptr->left_child();
+
+    // Left sub-tree reaches the query?
+    if (!left_ptr->empty() && !(left_ptr->summary() < query.low))
+    {
+      // Go left.
+      node_ptr = left_ptr;
+    }
+    else
+    {
+      // Go right.
+      node_ptr = node_ptr->right_child();
+    }
+  }
+
+  // No overlap.
+  return false;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // INTERVAL_TREE_CPP_
+//
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ *
+ * @file IntervalTree.h
+ *
+ * @brief Interval tree definitions built on the red-black node class.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the Interval value type, the augmentation policy caching
+ *          the maximum endpoint of each sub-tree and the overlap queries. The
+ *          tree is a RedBlackNode keyed on interval start, so the endpoint
+ *          cache is kept up to date by the node's own rotations and fixups.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef INTERVAL_TREE_H_
+#define INTERVAL_TREE_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <memory>
+#include <vector>
+#include <limits>
+#include <iterator>
+#include <cstddef>
+#include "../RedBlackNode/RedBlackNode.h"
+//
+//  Class Definitions  /////////////////////////////////////////////////////////
+//
+template<class T>
+struct Interval
+{
+    T low; /**< Inclusive start */
+    T high; /**< Inclusive end */
+
+    bool overlaps(const Interval<T>&) const; /**< Returns boolean indicating whether both (closed) intervals intersect */
+};
+
+template<class T>
+bool operator==(const Interval<T>&, const Interval<T>&); /**< Equal start and end */
+template<class T>
+bool operator<(const Interval<T>&, const Interval<T>&); /**< Orders by start, then by end */
+template<class T>
+bool operator<=(const Interval<T>&, const Interval<T>&); /**< Orders by start, then by end */
+
+template<class T>
+struct MaxEndpointAugment
+{
+    typedef T summary_type; /**< Largest endpoint in a sub-tree */
+    static constexpr bool enabled = true; /**< Summaries are maintained */
+
+    static summary_type identity(); /**< Returns the smallest representable value */
+    static summary_type lift(const Interval<T>&); /**< Returns the interval end */
+    static summary_type combine(const summary_type&, const summary_type&); /**< Returns the larger endpoint */
+};
+
+template<class T>
+using IntervalNode = RedBlackNode< Interval< T >, MaxEndpointAugment< T > >; /**< Red-black node keyed on interval start */
+
+template<class T>
+class IntervalOverlapIterator
+{
+// Public members.
+public:
+    typedef std::input_iterator_tag iterator_category; /**< Single pass */
+    typedef Interval< T > value_type; /**< Enumerated intervals */
+    typedef std::ptrdiff_t difference_type; /**< Unused */
+    typedef const Interval< T >* pointer; /**< Pointer to current interval */
+    typedef const Interval< T >& reference; /**< Reference to current interval */
+
+    IntervalOverlapIterator(); /**< End iterator */
+    IntervalOverlapIterator(std::shared_ptr< IntervalNode< T > >, const Interval< T >&); /**< Positions on the first overlap */
+
+    reference operator*() const; /**< Returns current interval */
+    pointer operator->() const; /**< Returns pointer to current interval */
+    IntervalOverlapIterator<T>& operator++(); /**< Advances to the next overlap */
+    bool operator==(const IntervalOverlapIterator<T>&) const; /**< Both exhausted or on the same node */
+    bool operator!=(const IntervalOverlapIterator<T>&) const; /**< Negation of equality */
+
+// Private members.
+private:
+    Interval< T > query_; /**< Interval being matched */
+    std::vector< std::shared_ptr< IntervalNode< T > > > stack_; /**< Nodes whose value and right sub-tree are still pending */
+    std::shared_ptr< IntervalNode< T > > current_ptr_; /**< Node holding the current overlap (nullptr when exhausted) */
+    Interval< T > current_; /**< Value of the current overlap */
+
+    void push_left(std::shared_ptr< IntervalNode< T > >); /**< Stacks the left spine of sub-trees that may hold an overlap */
+    void advance(); /**< Moves to the next overlap in order */
+};
+
+template<class T>
+class IntervalOverlapRange
+{
+// Public members.
+public:
+    IntervalOverlapRange(std::shared_ptr< IntervalNode< T > >, const Interval< T >&); /**< Default constructor */
+
+    IntervalOverlapIterator<T> begin() const; /**< Starts the enumeration */
+    IntervalOverlapIterator<T> end() const; /**< Returns the end iterator */
+
+// Private members.
+private:
+    std::shared_ptr< IntervalNode< T > > root_ptr_; /**< Root of the tree to search */
+    Interval< T > query_; /**< Interval being matched */
+};
+//
+//  Namespace Definition  //////////////////////////////////////////////////////
+//
+namespace interval_tree
+{
+  // Enumerate overlaps.
+  template<class T>
+  IntervalOverlapRange<T> overlapping(
+    std::shared_ptr< IntervalNode< T > >,
+    const Interval< T >&
+  ); /**< Returns a lazy, in-order enumeration of the k stored intervals overlapping the query in O(min(n, (k + 1) log n)). */
+
+  // Test for any overlap.
+  template<class T>
+  bool any_overlap(
+    std::shared_ptr< IntervalNode< T > >,
+    const Interval< T >&
+  ); /**< Returns boolean indicating whether any stored interval overlaps the query in O(log n). */
+}
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "IntervalTree.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // INTERVAL_TREE_H_
+//
\ No newline at end of file
@@ -0,0 +1,409 @@
+/**
+ *
+ * @file LeafBlock.cpp
+ *
+ * @brief Leaf block class implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the LeafBlock class and the LeafBlockRef comparisons.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef LEAF_BLOCK_CPP_
+#define LEAF_BLOCK_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <algorithm>
+#include "LeafBlock.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Default initializes an empty, unlinked block
+ *
+ * @param[in] fence
+ *            Key the block is indexed by.
+ *
+ */
+template<typename T>
+LeafBlock<T>::LeafBlock(const T& fence)
+    : keys_(),
+      size_(0),
+      fence_(fence),
+      next_ptr_(nullptr),
+      previous_ptr_() {}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Releases the following blocks this block alone keeps alive one at a
+ *          time, so a long chain does not destruct recursively
+ *
+ */
+template<typename T>
+LeafBlock<T>::~LeafBlock()
+{
+    // Take chain.
+    auto next_ptr = std::move(next_ptr_);
+
+    // Release sole-owned blocks iteratively.
+    while (next_ptr && next_ptr.use_count() == 1)
+    {
+        // Detach and drop.
+        auto after_ptr = std::move(next_ptr->next_ptr_);
+        next_ptr = std::move(after_ptr);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the number of keys in the block
+ *
+ * @return Number of keys
+ *
+ */
+template<typename T>
+std::size_t LeafBlock<T>::size() const
+{
+    // Return size.
+    return size_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a boolean value indicating if the block is empty
+ *
+ * @return Boolean value indicating if the block is empty
+ *
+ */
+template<typename T>
+bool LeafBlock<T>::empty() const
+{
+    // No keys.
+    return size_ == 0;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a boolean value indicating if the block is at capacity
+ *
+ * @return Boolean value indicating if the block is full
+ *
+ */
+template<typename T>
+bool LeafBlock<T>::full() const
+{
+    // At capacity.
+    return size_ == LEAF_BLOCK_CAPACITY;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the key the block is indexed by
+ *
+ * @return Fence key
+ *
+ */
+template<typename T>
+const T& LeafBlock<T>::fence() const
+{
+    // Return fence.
+    return fence_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a smart pointer to the following block
+ *
+ * @return Smart pointer to the following block (nullptr if last)
+ *
+ */
+template<typename T>
+std::shared_ptr< LeafBlock< T > > LeafBlock<T>::next() const
+{
+    // Return next.
+    return next_ptr_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a smart pointer to the preceding block
+ *
+ * @return Smart pointer to the preceding block (nullptr if first)
+ *
+ */
+template<typename T>
+std::shared_ptr< LeafBlock< T > > LeafBlock<T>::previous() const
+{
+    // Return previous.
+    return previous_ptr_.lock();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Searches the block for the key
+ *
+ * @param[in] key
+ *            Key to search for.
+ *
+ * @return Boolean value that represents the results of the search.
+ *
+ */
+template<typename T>
+bool LeafBlock<T>::contains(const T& key) const
+{
+    // Position of key.
+    auto index = lower_bound(key);
+
+    // Present?
+    return index < size_ && !(key < keys_[index]);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Inserts the key at its sorted position, shifting larger keys up
+ *
+ * @param[in] key
+ *            Key to insert.
+ *
+ * @return Boolean value indicating success (false when full or present)
+ *
+ */
+template<typename T>
+bool LeafBlock<T>::insert(const T& key)
+{
+    // Position of key.
+    auto index = lower_bound(key);
+
+    // Full or present?
+    if (full() || (index < size_ && !(key < keys_[index])))
+    {
+        // Return failure.
+        return false;
+    }
+
+    // Shift and place.
+    std::move_backward(keys_ + index, keys_ + size_, keys_ + size_ + 1);
+    keys_[index] = key;
+    ++size_;
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Removes the key, shifting larger keys down
+ *
+ * @param[in] key
+ *            Key to remove.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+template<typename T>
+bool LeafBlock<T>::erase(const T& key)
+{
+    // Position of key.
+    auto index = lower_bound(key);
+
+    // Missing?
+    if (index == size_ || key < keys_[index])
+    {
+        // Return failure.
+        return false;
+    }
+
+    // Shift.
+    std::move(keys_ + index + 1, keys_ + size_, keys_ + index);
+    --size_;
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Moves the upper half of the keys into a new block (fenced by its
+ *          smallest key) and links it after this block
+ *
+ * @return Smart pointer to the new block
+ *
+ */
+template<typename T>
+std::shared_ptr< LeafBlock< T > > LeafBlock<T>::split()
+{
+    // Split point.
+    auto middle = size_ / 2;
+
+    // New block.
+    auto upper_ptr = std::make_shared< LeafBlock< T > >(keys_[middle]);
+    std::move(keys_ + middle, keys_ + size_, upper_ptr->keys_);
+    upper_ptr->size_ = size_ - middle;
+    size_ = middle;
+
+    // Link.
+    upper_ptr->next_ptr_ = next_ptr_;
+    upper_ptr->previous_ptr_ = this->shared_from_this();
+    if (next_ptr_)
+    {
+        // Back link.
+        next_ptr_->previous_ptr_ = upper_ptr;
+    }
+    next_ptr_ = upper_ptr;
+
+    // Return new block.
+    return upper_ptr;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Appends the keys of the following block (all larger than these)
+ *          and unlinks it. The caller ensures both fit.
+ *
+ */
+template<typename T>
+void LeafBlock<T>::absorb_next()
+{
+    // Save next.
+    auto next_ptr = next_ptr_;
+
+    // Append.
+    std::move(next_ptr->keys_, next_ptr->keys_ + next_ptr->size_, keys_ + size_);
+    size_ += next_ptr->size_;
+    next_ptr->size_ = 0;
+
+    // Unlink.
+    next_ptr_ = next_ptr->next_ptr_;
+    if (next_ptr_)
+    {
+        // Back link.
+        next_ptr_->previous_ptr_ = this->shared_from_this();
+    }
+    next_ptr->next_ptr_ = nullptr;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Executes the iteratee on each key in order. The smart pointers
+ *          share ownership of the block instead of allocating per key.
+ *
+ * @param[in] iteratee
+ *            Function to execute with each key.
+ *
+ */
+template<typename T>
+void LeafBlock<T>::each(std::function< void(std::shared_ptr< T >) > iteratee)
+{
+    // Owner.
+    auto self_ptr = this->shared_from_this();
+
+    // Visit.
+    for (std::size_t i = 0; i < size_; i++)
+    {
+        // Process (aliasing pointer).
+        iteratee(std::shared_ptr< T >(self_ptr, keys_ + i));
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the index of the first key not less than the probe
+ *
+ * @param[in] key
+ *            Probe.
+ *
+ * @return Index in [0, size]
+ *
+ */
+template<typename T>
+std::size_t LeafBlock<T>::lower_bound(const T& key) const
+{
+    // Search (SIMD for 32-bit integers).
+    return leaf_search::count_less(keys_, size_, key);
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @details Compares two references by fence
+ *
+ * @return Boolean value indicating whether the fences are equal
+ *
+ */
+template<typename T>
+bool operator==(const LeafBlockRef<T>& lhs, const LeafBlockRef<T>& rhs)
+{
+    // Compare fences.
+    return !(lhs.fence < rhs.fence) && !(rhs.fence < lhs.fence);
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @details Orders two references by fence
+ *
+ * @return Boolean value indicating whether lhs orders before rhs
+ *
+ */
+template<typename T>
+bool operator<(const LeafBlockRef<T>& lhs, const LeafBlockRef<T>& rhs)
+{
+    // Compare fences.
+    return lhs.fence < rhs.fence;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @details Orders two references by fence
+ *
+ * @return Boolean value indicating whether lhs does not order after rhs
+ *
+ */
+template<typename T>
+bool operator<=(const LeafBlockRef<T>& lhs, const LeafBlockRef<T>& rhs)
+{
+    // Not after.
+    return !(rhs.fence < lhs.fence);
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // LEAF_BLOCK_CPP_
+//
\ No newline at end of file
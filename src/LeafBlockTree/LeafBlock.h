@@ -0,0 +1,84 @@
+/**
+ *
+ * @file LeafBlock.h
+ *
+ * @brief Leaf block class definition.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the LeafBlock class, a fixed-capacity page of sorted,
+ *          unique keys stored inline, linked to its neighbours like B+ tree
+ *          leaves, and the LeafBlockRef handle the red-black tree indexes
+ *          blocks by.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef LEAF_BLOCK_H_
+#define LEAF_BLOCK_H_
+#define LEAF_BLOCK_CAPACITY 64
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <memory>
+#include <functional>
+#include <cstddef>
+#include "leaf_search.h"
+//
+//  Class Definitions  /////////////////////////////////////////////////////////
+//
+template<class T>
+class LeafBlock : public std::enable_shared_from_this< LeafBlock< T > >
+{
+// Public members.
+public:
+    LeafBlock(const T& fence); /**< Default constructor */
+    ~LeafBlock(); /**< Destructor */
+
+    std::size_t size() const; /**< Returns the number of keys */
+    bool empty() const; /**< Returns boolean indicating whether the block holds no keys */
+    bool full() const; /**< Returns boolean indicating whether the block is at capacity */
+    const T& fence() const; /**< Returns the key the block is indexed by */
+    std::shared_ptr< LeafBlock< T > > next() const; /**< Returns smart pointer to the following block */
+    std::shared_ptr< LeafBlock< T > > previous() const; /**< Returns smart pointer to the preceding block */
+    bool contains(const T&) const; /**< Check if the key exists in the block */
+    bool insert(const T&); /**< Inserts key in order and returns boolean value indicating success (not full, not present) */
+    bool erase(const T&); /**< Removes key and returns boolean value indicating success */
+    std::shared_ptr< LeafBlock< T > > split(); /**< Moves the upper half into a new block linked after this one */
+    void absorb_next(); /**< Appends every key of the following block and unlinks it */
+    void each(std::function< void(std::shared_ptr<T>) >); /**< Executes provided function on each key in order. */
+
+// Private members.
+private:
+    T keys_[LEAF_BLOCK_CAPACITY]; /**< Sorted keys (first size_ slots used) */
+    std::size_t size_; /**< Number of keys */
+    T fence_; /**< Key the block is indexed by (no greater than any key in it) */
+    std::shared_ptr< LeafBlock< T > > next_ptr_; /**< Smart pointer to the following block */
+    std::weak_ptr< LeafBlock< T > > previous_ptr_; /**< Weak pointer to the preceding block */
+
+    std::size_t lower_bound(const T&) const; /**< Returns the index of the first key not less than the probe */
+};
+
+template<class T>
+struct LeafBlockRef
+{
+    T fence; /**< Key the block is indexed by */
+    std::shared_ptr< LeafBlock< T > > block_ptr; /**< Smart pointer to the block (nullptr in search probes) */
+};
+
+template<class T>
+bool operator==(const LeafBlockRef<T>&, const LeafBlockRef<T>&); /**< Equal fences */
+template<class T>
+bool operator<(const LeafBlockRef<T>&, const LeafBlockRef<T>&); /**< Orders by fence */
+template<class T>
+bool operator<=(const LeafBlockRef<T>&, const LeafBlockRef<T>&); /**< Orders by fence */
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "LeafBlock.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // LEAF_BLOCK_H_
+//
\ No newline at end of file
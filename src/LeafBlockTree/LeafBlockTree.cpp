@@ -0,0 +1,337 @@
+/**
+ *
+ * @file LeafBlockTree.cpp
+ *
+ * @brief Leaf block tree class implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the LeafBlockTree class. Every block after the first is
+ *          indexed by its fence, a key no greater than any key it holds and
+ *          greater than every key of the blocks before it, so the block for a
+ *          key is the floor of the key in the index (or the first block when
+ *          the key is below every fence).
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef LEAF_BLOCK_TREE_CPP_
+#define LEAF_BLOCK_TREE_CPP_
+#define LEAF_BLOCK_MERGE_THRESHOLD (LEAF_BLOCK_CAPACITY / 4)
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include "LeafBlockTree.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Default initializes an empty index and one empty block
+ *
+ */
+template<typename T>
+LeafBlockTree<T>::LeafBlockTree()
+    : root_ptr_(std::make_shared< RedBlackNode< LeafBlockRef< T > > >(nullptr, false)),
+      first_block_ptr_(std::make_shared< LeafBlock< T > >(T())),
+      size_(0),
+      block_count_(1) {}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Frees the block index (its nodes link to each other, so they are
+ *          not released with the root pointer alone)
+ *
+ */
+template<typename T>
+LeafBlockTree<T>::~LeafBlockTree()
+{
+    // Free nodes.
+    root_ptr_->clear();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a boolean value indicating if the tree is empty
+ *
+ * @return Boolean value indicating if the tree is empty
+ *
+ */
+template<typename T>
+bool LeafBlockTree<T>::empty() const
+{
+    // No keys.
+    return size_ == 0;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the number of keys in the tree
+ *
+ * @return Number of keys
+ *
+ */
+template<typename T>
+std::size_t LeafBlockTree<T>::size() const
+{
+    // Return size.
+    return size_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the number of leaf blocks
+ *
+ * @return Number of blocks
+ *
+ */
+template<typename T>
+std::size_t LeafBlockTree<T>::block_count() const
+{
+    // Return block count.
+    return block_count_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the height of the block index plus one for the leaf level,
+ *          comparable with RedBlackNode::height for the same keys
+ *
+ * @return Height of the tree
+ *
+ */
+template<typename T>
+unsigned int LeafBlockTree<T>::height() const
+{
+    // Index and leaves.
+    return root_ptr_->height() + 1;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Searches the key's block
+ *
+ * @param[in] key
+ *            Value used for comparison in search.
+ *
+ * @return Boolean value that represents the results of the search.
+ *
+ */
+template<typename T>
+bool LeafBlockTree<T>::contains(const T& key) const
+{
+    // Search block.
+    return find_block(key)->contains(key);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Iterates over the blocks in order and executes the iteratee on each
+ *          key
+ *
+ * @param[in] iteratee
+ *            Function to execute with each key.
+ *
+ */
+template<typename T>
+void LeafBlockTree<T>::each_inorder(std::function< void(std::shared_ptr< T >) > iteratee)
+{
+    // Walk leaf chain.
+    for (auto block_ptr = first_block_ptr_; block_ptr; block_ptr = block_ptr->next())
+    {
+        // Process block.
+        block_ptr->each(iteratee);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Inserts the key into its block, splitting the block first if it is
+ *          full and indexing the upper half by its smallest key
+ *
+ * @param[in] key
+ *            Value to add.
+ *
+ * @return Boolean value indicating success (false if already present)
+ *
+ */
+template<typename T>
+bool LeafBlockTree<T>::add(const T& key)
+{
+    // Find block.
+    auto block_ptr = find_block(key);
+
+    // Already present?
+    if (block_ptr->contains(key))
+    {
+        // Return failure.
+        return false;
+    }
+
+    // Full?
+    if (block_ptr->full())
+    {
+        // Split and index upper half.
+        auto upper_ptr = block_ptr->split();
+        root_ptr_->add(LeafBlockRef< T >{upper_ptr->fence(), upper_ptr});
+        root_ptr_ = root_ptr_->root();
+        ++block_count_;
+
+        // Pick half.
+        if (!(key < upper_ptr->fence()))
+        {
+            // Upper.
+            block_ptr = upper_ptr;
+        }
+    }
+
+    // Insert.
+    block_ptr->insert(key);
+    ++size_;
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Removes the key from its block and merges a sparse block with its
+ *          following block, or else into its preceding block, when the keys
+ *          of both fit in one block
+ *
+ * @param[in] key
+ *            Value to remove.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+template<typename T>
+bool LeafBlockTree<T>::remove(const T& key)
+{
+    // Find block and erase.
+    auto block_ptr = find_block(key);
+    if (!block_ptr->erase(key))
+    {
+        // Return failure.
+        return false;
+    }
+    --size_;
+
+    // Still dense enough?
+    if (block_ptr->size() >= LEAF_BLOCK_MERGE_THRESHOLD)
+    {
+        // Return success.
+        return true;
+    }
+
+    // Absorb following block?
+    auto next_ptr = block_ptr->next();
+    if (next_ptr && block_ptr->size() + next_ptr->size() <= LEAF_BLOCK_CAPACITY)
+    {
+        // Merge.
+        unindex(next_ptr);
+        block_ptr->absorb_next();
+    }
+
+    // Absorbed by preceding block?
+    else if (block_ptr != first_block_ptr_)
+    {
+        // Preceding block.
+        auto previous_ptr = block_ptr->previous();
+        if (previous_ptr->size() + block_ptr->size() <= LEAF_BLOCK_CAPACITY)
+        {
+            // Merge.
+            unindex(block_ptr);
+            previous_ptr->absorb_next();
+        }
+    }
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Drops every block and the index
+ *
+ */
+template<typename T>
+void LeafBlockTree<T>::clear()
+{
+    // Free index nodes.
+    root_ptr_->clear();
+
+    // Reset.
+    first_block_ptr_ = std::make_shared< LeafBlock< T > >(T());
+    size_ = 0;
+    block_count_ = 1;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the block whose key range holds the key: the block with the
+ *          greatest fence not greater than the key, or the first block
+ *
+ * @param[in] key
+ *            Value used for comparison in search.
+ *
+ * @return Smart pointer to the block
+ *
+ */
+template<typename T>
+std::shared_ptr< LeafBlock< T > > LeafBlockTree<T>::find_block(const T& key) const
+{
+    // Floor of key in the index.
+    auto ref_ptr = root_ptr_->floor(LeafBlockRef< T >{key, nullptr});
+
+    // Below every fence?
+    return ref_ptr ? ref_ptr->block_ptr : first_block_ptr_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Removes the block's reference from the index
+ *
+ * @param[in] block_ptr
+ *            Indexed block (not the first block).
+ *
+ */
+template<typename T>
+void LeafBlockTree<T>::unindex(const std::shared_ptr< LeafBlock< T > >& block_ptr)
+{
+    // Remove by fence.
+    root_ptr_->remove(LeafBlockRef< T >{block_ptr->fence(), nullptr});
+    root_ptr_ = root_ptr_->root();
+    --block_count_;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#undef LEAF_BLOCK_MERGE_THRESHOLD
+#endif // LEAF_BLOCK_TREE_CPP_
+//
\ No newline at end of file
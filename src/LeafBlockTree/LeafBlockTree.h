@@ -0,0 +1,70 @@
+/**
+ *
+ * @file LeafBlockTree.h
+ *
+ * @brief Leaf block tree class definition.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the LeafBlockTree class, a hybrid mode where a red-black
+ *          tree indexes leaf blocks of up to LEAF_BLOCK_CAPACITY sorted keys
+ *          instead of holding one key per node. Blocks split when full and
+ *          merge with a neighbour when sparse, like B+ tree pages, so the tree
+ *          has one node per block and is several levels shallower. Keys are
+ *          unique (set semantics).
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef LEAF_BLOCK_TREE_H_
+#define LEAF_BLOCK_TREE_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <memory>
+#include <functional>
+#include <cstddef>
+#include "../RedBlackNode/RedBlackNode.h"
+#include "LeafBlock.h"
+//
+//  Class Definition  //////////////////////////////////////////////////////////
+//
+template<class T>
+class LeafBlockTree
+{
+// Public members.
+public:
+    LeafBlockTree(); /**< Default constructor */
+    LeafBlockTree(const LeafBlockTree<T>&) = delete; /**< Not copyable (copies would share the index) */
+    ~LeafBlockTree(); /**< Destructor (frees the index) */
+
+    bool empty() const; /**< Returns boolean indicating whether the tree is empty */
+    std::size_t size() const; /**< Returns the number of keys */
+    std::size_t block_count() const; /**< Returns the number of leaf blocks */
+    unsigned int height() const; /**< Returns height of the index tree plus the leaf level */
+    bool contains(const T&) const; /**< Check if the value exists in the tree */
+    void each_inorder(std::function< void(std::shared_ptr<T>) >); /**< Executes provided function on each item in-order. */
+    bool add(const T&); /**< Adds item to its leaf block and returns boolean value indicating success */
+    bool remove(const T&); /**< Removes value from its leaf block and returns boolean value indicating success */
+    void clear(); /**< Removes every item */
+
+// Private members.
+private:
+    std::shared_ptr< RedBlackNode< LeafBlockRef< T > > > root_ptr_; /**< Smart pointer to the root of the block index */
+    std::shared_ptr< LeafBlock< T > > first_block_ptr_; /**< Smart pointer to the first block (not indexed; holds keys below every fence) */
+    std::size_t size_; /**< Number of keys */
+    std::size_t block_count_; /**< Number of blocks */
+
+    std::shared_ptr< LeafBlock< T > > find_block(const T&) const; /**< Returns the block whose range holds the key */
+    void unindex(const std::shared_ptr< LeafBlock< T > >&); /**< Removes the block's reference from the index */
+};
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "LeafBlockTree.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // LEAF_BLOCK_TREE_H_
+//
\ No newline at end of file
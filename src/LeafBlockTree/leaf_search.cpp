@@ -0,0 +1,191 @@
+/**
+ *
+ * @file leaf_search.cpp
+ *
+ * @brief Implements in-leaf search functions.
+ *
+ * @author Josh Wiley
+ *
+ * @details The SIMD scans compare every key against the probe and count the
+ *          matching lanes. For sorted keys that count is the lower bound, and
+ *          a leaf is small enough that a branch-free scan beats the
+ *          mispredicted branches of a binary search. Unsigned keys are biased
+ *          by the sign bit so the signed vector compare orders them
+ *          correctly. The overloads are not templates, so they are inline.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef LEAF_SEARCH_CPP_
+#define LEAF_SEARCH_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <algorithm>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "leaf_search.h"
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Counts sorted 32-bit keys less than the probe
+ *
+ * @details Shared body of the integer overloads; the bias is xor-ed into keys
+ *          and probe before the signed compare.
+ *
+ * @param[in] keys_ptr
+ *            Sorted keys.
+ *
+ * @param[in] size
+ *            Number of keys.
+ *
+ * @param[in] probe
+ *            Probe (as a raw 32-bit pattern).
+ *
+ * @param[in] bias
+ *            Pattern xor-ed into each value (sign bit for unsigned keys).
+ *
+ * @return Number of keys less than the probe
+ *
+ */
+inline std::size_t leaf_search::count_less_32(
+  const std::int32_t* keys_ptr,
+  std::size_t size,
+  std::int32_t probe,
+  std::int32_t bias
+)
+{
+  // Count and cursor.
+  std::size_t count = 0;
+  std::size_t i = 0;
+
+#if defined(__AVX2__)
+  // Compare 8 keys at a time.
+  auto bias_vec = _mm256_set1_epi32(bias);
+  auto probe_vec = _mm256_xor_si256(_mm256_set1_epi32(probe), bias_vec);
+  for (; i + 8 <= size; i += 8)
+  {
+    // Lanes where key < probe.
+    auto keys_vec = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) (keys_ptr + i)), bias_vec);
+    auto mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(probe_vec, keys_vec)));
+    count += __builtin_popcount(mask);
+  }
+#elif defined(__SSE2__)
+  // Compare 4 keys at a time.
+  auto bias_vec = _mm_set1_epi32(bias);
+  auto probe_vec = _mm_xor_si128(_mm_set1_epi32(probe), bias_vec);
+  for (; i + 4 <= size; i += 4)
+  {
+    // Lanes where key < probe.
+    auto keys_vec = _mm_xor_si128(_mm_loadu_si128((const __m128i*) (keys_ptr + i)), bias_vec);
+    auto mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(probe_vec, keys_vec)));
+    count += __builtin_popcount(mask);
+  }
+#endif
+
+  // Remaining keys (all of them without SIMD).
+  for (; i < size; i++)
+  {
+    // Count.
+    count += (keys_ptr[i] ^ bias) < (probe ^ bias);
+  }
+
+  // Return count.
+  return count;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Counts sorted keys less than the probe
+ *
+ * @details Binary search for key types without a SIMD scan.
+ *
+ * @param[in] keys_ptr
+ *            Sorted keys.
+ *
+ * @param[in] size
+ *            Number of keys.
+ *
+ * @param[in] probe
+ *            Value to search for.
+ *
+ * @return Number of keys less than the probe
+ *
+ */
+template<class T>
+std::size_t leaf_search::count_less(
+  const T* keys_ptr,
+  std::size_t size,
+  const T& probe
+)
+{
+  // Binary search.
+  return std::lower_bound(keys_ptr, keys_ptr + size, probe) - keys_ptr;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Counts sorted unsigned keys less than the probe
+ *
+ * @param[in] keys_ptr
+ *            Sorted keys.
+ *
+ * @param[in] size
+ *            Number of keys.
+ *
+ * @param[in] probe
+ *            Value to search for.
+ *
+ * @return Number of keys less than the probe
+ *
+ */
+inline std::size_t leaf_search::count_less(
+  const unsigned int* keys_ptr,
+  std::size_t size,
+  const unsigned int& probe
+)
+{
+  // Scan with sign-bit bias.
+  return count_less_32((const std::int32_t*) keys_ptr, size, (std::int32_t) probe, INT32_MIN);
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Counts sorted signed keys less than the probe
+ *
+ * @param[in] keys_ptr
+ *            Sorted keys.
+ *
+ * @param[in] size
+ *            Number of keys.
+ *
+ * @param[in] probe
+ *            Value to search for.
+ *
+ * @return Number of keys less than the probe
+ *
+ */
+inline std::size_t leaf_search::count_less(
+  const int* keys_ptr,
+  std::size_t size,
+  const int& probe
+)
+{
+  // Scan without bias.
+  return count_less_32((const std::int32_t*) keys_ptr, size, probe, 0);
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // LEAF_SEARCH_CPP_
+//
\ No newline at end of file
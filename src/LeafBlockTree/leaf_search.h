@@ -0,0 +1,69 @@
+/**
+ *
+ * @file leaf_search.h
+ *
+ * @brief Namespace for in-leaf search functions.
+ *
+ * @author Josh Wiley
+ *
+ * @details Provides the search used inside a leaf block: counting the sorted
+ *          keys less than a probe (its lower bound). 32-bit integer keys are
+ *          compared 8 at a time with AVX2 when compiled with -mavx2, 4 at a
+ *          time with SSE2 otherwise, and one at a time without either; other
+ *          key types use a binary search.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef LEAF_SEARCH_H_
+#define LEAF_SEARCH_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <cstddef>
+#include <cstdint>
+//
+//  Namespace Definition  //////////////////////////////////////////////////////
+//
+namespace leaf_search
+{
+  // Shared 32-bit scan.
+  inline std::size_t count_less_32(
+    const std::int32_t*,
+    std::size_t,
+    std::int32_t,
+    std::int32_t
+  ); /**< Returns the number of sorted (biased) 32-bit keys less than the probe. */
+
+  // Lower bound of any ordered key type.
+  template<class T>
+  std::size_t count_less(
+    const T*,
+    std::size_t,
+    const T&
+  ); /**< Returns the number of sorted keys less than the probe (binary search). */
+
+  // Lower bound of unsigned 32-bit keys.
+  inline std::size_t count_less(
+    const unsigned int*,
+    std::size_t,
+    const unsigned int&
+  ); /**< Returns the number of sorted keys less than the probe (SIMD scan). */
+
+  // Lower bound of signed 32-bit keys.
+  inline std::size_t count_less(
+    const int*,
+    std::size_t,
+    const int&
+  ); /**< Returns the number of sorted keys less than the probe (SIMD scan). */
+}
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "leaf_search.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // LEAF_SEARCH_H_
+//
\ No newline at end of file
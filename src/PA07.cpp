@@ -2,12 +2,25 @@
  *
  * @file PA07.cpp
  *
- * @brief Driver for red-black tree ADT.
+ * @brief Workload driver for red-black tree ADT.
  *
  * @author Josh Wiley
  *
- * @details Generates random data, inserts into red-black trees, and tests
- *          member functions.
+ * @details Replays a recorded operation trace, or a synthetic operation mix,
+ *          against a shared red-black tree from a configurable number of
+ *          threads and reports throughput and per-operation latency
+ *          percentiles. The threads share one reader-writer lock on the
+ *          tree: lookups and range queries run concurrently, while adds and
+ *          removes run one at a time and exclude all readers. Extra threads
+ *          therefore speed up read-heavy mixes only; in write-heavy mixes the
+ *          latencies mostly measure waiting for the lock.
+ *
+ *          Usage: PA07 [CONFIG_FILE] [key=value ...]
+ *
+ *          Settings (later ones win): trace, threads, operations, preload,
+ *          key_space, range_width, add, contains, remove, range (mix
+ *          percentages) and seed. Without arguments a default synthetic mix
+ *          runs on one thread.
  *
  */
 //
@@ -15,74 +28,220 @@
 //
 #ifndef PA07_CPP_
 #define PA07_CPP_
-#define DATA_SET_SIZE 1000
-#define DATA_SET_MIN 1
-#define DATA_SET_MAX 10000
 //
 //  Header Files  //////////////////////////////////////////////////////////////
 //
 #include <iostream>
+#include <iomanip>
 #include <memory>
-#include <algorithm>
-#include "utils/data_generator.h"
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <random>
+#include <vector>
+#include <string>
+#include <stdexcept>
 #include "RedBlackNode/RedBlackNode.h"
+#include "utils/workload.h"
+#include "utils/latency_histogram.h"
+//
+//  Type Definitions  //////////////////////////////////////////////////////////
+//
+typedef RedBlackNode< unsigned int, CountAugment< unsigned int > > Tree; /**< Tree under test (counts back range queries) */
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Prints one latency row
+ *
+ * @param[in] name
+ *            Row label.
+ *
+ * @param[in] histogram
+ *            Latencies of the row (nanoseconds).
+ *
+ */
+void report(const char* name, const LatencyHistogram& histogram)
+{
+    // Row (microseconds).
+    std::cout << "  " << std::left << std::setw(10) << name << std::right
+              << std::setw(10) << histogram.count() << std::fixed << std::setprecision(2)
+              << std::setw(10) << histogram.mean() / 1000
+              << std::setw(10) << histogram.percentile(50) / 1000.0
+              << std::setw(10) << histogram.percentile(99) / 1000.0
+              << std::setw(10) << histogram.percentile(99.9) / 1000.0
+              << std::setw(10) << histogram.max() / 1000.0 << '\n';
+}
 //
 //  Main Function Implementation  //////////////////////////////////////////////
 //
-int main()
+int main(int argc, char** argv)
 {
+    // Configuration and operations.
+    workload::Config config;
+    std::vector< workload::Step > steps;
+    try
+    {
+        // Arguments (settings or a config file).
+        for (int i = 1; i < argc; i++)
+        {
+            // Apply.
+            std::string argument(argv[i]);
+            if (argument.find('=') != std::string::npos)
+            {
+                // Setting.
+                workload::set(config, argument);
+            }
+            else
+            {
+                // File.
+                workload::load_config(config, argument);
+            }
+        }
+
+        // Trace or synthetic mix.
+        steps = config.trace.empty() ? workload::generate(config) : workload::load_trace(config.trace);
+    }
+    catch (const std::exception& error)
+    {
+        // Report and exit (failure).
+        std::cerr << "PA07: " << error.what() << std::endl;
+        return 1;
+    }
+
     // Red-black tree.
-    auto rbt_root_ptr = std::make_shared< RedBlackNode< unsigned int > >(nullptr, false);
+    auto rbt_root_ptr = std::make_shared< Tree >(nullptr, false);
 
-    // Test data.
-    auto data_set_ptr = std::make_shared< std::list< unsigned int > >();
+    // Preload random keys.
+    std::mt19937 generator(config.seed + 1);
+    std::uniform_int_distribution< unsigned int > keys(0, config.key_space - 1);
+    std::vector< unsigned int > preload(config.preload);
+    for (auto& key : preload)
+    {
+        // Generate.
+        key = keys(generator);
+    }
+    rbt_root_ptr->insert_batch(preload.begin(), preload.end(), config.threads);
+    rbt_root_ptr = rbt_root_ptr->root();
 
-    // Generate test data.
-    data_generator::generate_random_data(
-        DATA_SET_SIZE,
-        DATA_SET_MIN,
-        DATA_SET_MAX,
-        data_set_ptr
+    // Shared tree guard (writers exclusive), per-thread latencies and result counters.
+    std::shared_timed_mutex tree_mutex;
+    std::vector< std::vector< LatencyHistogram > > latencies(
+        config.threads,
+        std::vector< LatencyHistogram >(workload::OPERATION_COUNT)
     );
+    std::vector< unsigned long > results(config.threads, 0);
 
-    // Iterators.
-    auto cursor_it = data_set_ptr->begin();
-    auto end_it = data_set_ptr->end();
+    // Worker (every threads-th operation, in trace order).
+    auto worker = [&] (unsigned int thread) {
+        for (std::size_t i = thread; i < steps.size(); i += config.threads)
+        {
+            // Time the operation, including the wait for the tree.
+            const auto& step = steps[i];
+            auto start = std::chrono::steady_clock::now();
+            if (step.operation == workload::ADD || step.operation == workload::REMOVE)
+            {
+                // Exclusive lock.
+                std::lock_guard< std::shared_timed_mutex > lock(tree_mutex);
 
-    // Build tree.
-    while (cursor_it != end_it)
-    {   
-        // Add item and update.
-        rbt_root_ptr->add(*cursor_it);
+                // Apply and update root.
+                if (step.operation == workload::ADD)
+                {
+                    // Add.
+                    rbt_root_ptr->add(step.key);
+                }
+                else
+                {
+                    // Remove.
+                    rbt_root_ptr->remove(step.key);
+                }
+                rbt_root_ptr = rbt_root_ptr->root();
+            }
+            else
+            {
+                // Shared lock (reads only).
+                std::shared_lock< std::shared_timed_mutex > lock(tree_mutex);
 
-        // Root fell?
-        if (rbt_root_ptr->is_root())
-        {
-            // Update.
-            rbt_root_ptr = rbt_root_ptr->parent();
+                // Apply.
+                if (step.operation == workload::CONTAINS)
+                {
+                    // Lookup.
+                    results[thread] += rbt_root_ptr->contains(step.key);
+                }
+                else
+                {
+                    // Range count.
+                    results[thread] += rbt_root_ptr->aggregate(step.key, step.high);
+                }
+            }
+            latencies[thread][step.operation].record(
+                std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now() - start).count()
+            );
         }
+    };
 
-        // Advance.
-        ++cursor_it;
+    // Run.
+    auto start = std::chrono::steady_clock::now();
+    std::vector< std::thread > workers;
+    for (unsigned int thread = 1; thread < config.threads; thread++)
+    {
+        // Spawn.
+        workers.emplace_back(worker, thread);
     }
+    worker(0);
+    for (auto& thread : workers)
+    {
+        // Wait.
+        thread.join();
+    }
+    auto seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
 
-    // Display height.
-    std::cout << "\n\nRBT height: " << rbt_root_ptr->height();
-
-    // Display sum.
-    auto sum_ptr = std::make_shared< long >(0);
-    rbt_root_ptr->each_inorder([sum_ptr] (auto i) { *sum_ptr += *i; });
-    std::cout << "\n\nRBT sum: " << *sum_ptr;
+    // Merge latencies.
+    std::vector< LatencyHistogram > totals(workload::OPERATION_COUNT);
+    LatencyHistogram overall;
+    unsigned long result_total = 0;
+    for (unsigned int thread = 0; thread < config.threads; thread++)
+    {
+        // Merge thread.
+        for (unsigned int operation = 0; operation < workload::OPERATION_COUNT; operation++)
+        {
+            // Merge.
+            totals[operation].merge(latencies[thread][operation]);
+            overall.merge(latencies[thread][operation]);
+        }
+        result_total += results[thread];
+    }
 
-    // Display empty state.
-    std::cout << "\n\nRBT empty state: " << rbt_root_ptr->empty();
+    // Display run.
+    std::cout << "\n\nWorkload: " << (config.trace.empty() ? "synthetic mix" : config.trace)
+              << ", " << steps.size() << " operations, " << config.threads << " thread(s), "
+              << config.preload << " keys preloaded"
+              << "\n\nLocking: one reader-writer lock (contains/range shared, add/remove exclusive)";
+    std::cout << "\n\nThroughput: " << (long) (steps.size() / seconds) << " ops/s"
+              << " (" << std::fixed << std::setprecision(3) << seconds << " s)";
 
-    // Clear.
-    std::cout << "\n\nClearing RBT...";
-    rbt_root_ptr->clear();
+    // Display latencies.
+    std::cout << "\n\nLatency (us):\n"
+              << "  " << std::left << std::setw(10) << "operation" << std::right
+              << std::setw(10) << "count" << std::setw(10) << "mean" << std::setw(10) << "p50"
+              << std::setw(10) << "p99" << std::setw(10) << "p999" << std::setw(10) << "max" << '\n';
+    for (unsigned int operation = 0; operation < workload::OPERATION_COUNT; operation++)
+    {
+        // Row (skip unused operations).
+        if (totals[operation].count())
+        {
+            // Display.
+            report(workload::name((workload::Operation) operation), totals[operation]);
+        }
+    }
+    report("all", overall);
 
-    // Display empty state (again).
-    std::cout << "\n\nRBT empty state: " << rbt_root_ptr->empty();
+    // Display final state.
+    std::cout << "\nRBT height: " << rbt_root_ptr->height()
+              << "\n\nRBT size: " << rbt_root_ptr->summary()
+              << "\n\nLookup hits + range matches: " << result_total;
 
     // Padding and flush stream.
     std::cout << '\n' << std::endl;
@@ -94,4 +253,4 @@ int main()
 //  Terminating Precompiler Directives  ////////////////////////////////////////
 //
 #endif // PA07_CPP_
-//
\ No newline at end of file
+//
@@ -0,0 +1,400 @@
+/**
+ *
+ * @file RedBlackAugment.cpp
+ *
+ * @brief Augmentation policy implementations.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the monoids defined in RedBlackAugment.h.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef RED_BLACK_AUGMENT_CPP_
+#define RED_BLACK_AUGMENT_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include "RedBlackAugment.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the empty summary
+ *
+ * @return Empty summary
+ *
+ */
+template<typename T>
+typename NoAugment<T>::summary_type NoAugment<T>::identity()
+{
+    // Nothing to summarize.
+    return summary_type();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the empty summary
+ *
+ * @return Empty summary
+ *
+ */
+template<typename T>
+typename NoAugment<T>::summary_type NoAugment<T>::lift(const T&)
+{
+    // Nothing to summarize.
+    return summary_type();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the empty summary
+ *
+ * @return Empty summary
+ *
+ */
+template<typename T>
+typename NoAugment<T>::summary_type NoAugment<T>::combine(
+    const summary_type&,
+    const summary_type&
+)
+{
+    // Nothing to summarize.
+    return summary_type();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the sum of an empty sub-tree
+ *
+ * @return Zero
+ *
+ */
+template<typename T, typename S>
+typename SumAugment<T, S>::summary_type SumAugment<T, S>::identity()
+{
+    // Zero.
+    return summary_type(0);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the sum of a single value
+ *
+ * @param[in] value
+ *            Value to lift
+ *
+ * @return Value as a sum
+ *
+ */
+template<typename T, typename S>
+typename SumAugment<T, S>::summary_type SumAugment<T, S>::lift(const T& value)
+{
+    // Value as sum.
+    return summary_type(value);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the sum of two adjacent sub-trees
+ *
+ * @param[in] lhs
+ *            Sum of the left sub-tree
+ *
+ * @param[in] rhs
+ *            Sum of the right sub-tree
+ *
+ * @return Combined sum
+ *
+ */
+template<typename T, typename S>
+typename SumAugment<T, S>::summary_type SumAugment<T, S>::combine(
+    const summary_type& lhs,
+    const summary_type& rhs
+)
+{
+    // Add.
+    return lhs + rhs;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the largest representable value (summary of an empty sub-tree)
+ *
+ * @return The largest representable value
+ *
+ */
+template<typename T>
+typename MinAugment<T>::summary_type MinAugment<T>::identity()
+{
+    // Bound.
+    return std::numeric_limits< T >::max();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of a single value
+ *
+ * @param[in] value
+ *            Value to lift
+ *
+ * @return The value
+ *
+ */
+template<typename T>
+typename MinAugment<T>::summary_type MinAugment<T>::lift(const T& value)
+{
+    // Value.
+    return value;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the minimum of two adjacent sub-trees
+ *
+ * @param[in] lhs
+ *            Summary of the left sub-tree
+ *
+ * @param[in] rhs
+ *            Summary of the right sub-tree
+ *
+ * @return Smaller value
+ *
+ */
+template<typename T>
+typename MinAugment<T>::summary_type MinAugment<T>::combine(
+    const summary_type& lhs,
+    const summary_type& rhs
+)
+{
+    // Compare.
+    return std::min(lhs, rhs);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the smallest representable value (summary of an empty sub-tree)
+ *
+ * @return The smallest representable value
+ *
+ */
+template<typename T>
+typename MaxAugment<T>::summary_type MaxAugment<T>::identity()
+{
+    // Bound.
+    return std::numeric_limits< T >::lowest();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of a single value
+ *
+ * @param[in] value
+ *            Value to lift
+ *
+ * @return The value
+ *
+ */
+template<typename T>
+typename MaxAugment<T>::summary_type MaxAugment<T>::lift(const T& value)
+{
+    // Value.
+    return value;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the maximum of two adjacent sub-trees
+ *
+ * @param[in] lhs
+ *            Summary of the left sub-tree
+ *
+ * @param[in] rhs
+ *            Summary of the right sub-tree
+ *
+ * @return Larger value
+ *
+ */
+template<typename T>
+typename MaxAugment<T>::summary_type MaxAugment<T>::combine(
+    const summary_type& lhs,
+    const summary_type& rhs
+)
+{
+    // Compare.
+    return std::max(lhs, rhs);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the count of an empty sub-tree
+ *
+ * @return Zero
+ *
+ */
+template<typename T>
+typename CountAugment<T>::summary_type CountAugment<T>::identity()
+{
+    // Zero.
+    return 0;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the count of a single value
+ *
+ * @return One
+ *
+ */
+template<typename T>
+typename CountAugment<T>::summary_type CountAugment<T>::lift(const T&)
+{
+    // One.
+    return 1;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the count of two adjacent sub-trees
+ *
+ * @param[in] lhs
+ *            Count of the left sub-tree
+ *
+ * @param[in] rhs
+ *            Count of the right sub-tree
+ *
+ * @return Combined count
+ *
+ */
+template<typename T>
+typename CountAugment<T>::summary_type CountAugment<T>::combine(
+    const summary_type& lhs,
+    const summary_type& rhs
+)
+{
+    // Add.
+    return lhs + rhs;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of an empty sub-tree under every policy
+ *
+ * @return Tuple of identities
+ *
+ */
+template<typename T, typename... A>
+typename CompositeAugment<T, A...>::summary_type CompositeAugment<T, A...>::identity()
+{
+    // Each identity.
+    return summary_type(A::identity()...);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of a single value under every policy
+ *
+ * @param[in] value
+ *            Value to lift
+ *
+ * @return Tuple of lifted values
+ *
+ */
+template<typename T, typename... A>
+typename CompositeAugment<T, A...>::summary_type CompositeAugment<T, A...>::lift(const T& value)
+{
+    // Each lift.
+    return summary_type(A::lift(value)...);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of two adjacent sub-trees under every policy
+ *
+ * @param[in] lhs
+ *            Summary of the left sub-tree
+ *
+ * @param[in] rhs
+ *            Summary of the right sub-tree
+ *
+ * @return Tuple of combined summaries
+ *
+ */
+template<typename T, typename... A>
+typename CompositeAugment<T, A...>::summary_type CompositeAugment<T, A...>::combine(
+    const summary_type& lhs,
+    const summary_type& rhs
+)
+{
+    // Combine element-wise.
+    return combine(lhs, rhs, std::index_sequence_for< A... >());
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Combines the I-th summaries with the I-th policy
+ *
+ * @param[in] lhs
+ *            Summary of the left sub-tree
+ *
+ * @param[in] rhs
+ *            Summary of the right sub-tree
+ *
+ * @return Tuple of combined summaries
+ *
+ */
+template<typename T, typename... A>
+template<std::size_t... I>
+typename CompositeAugment<T, A...>::summary_type CompositeAugment<T, A...>::combine(
+    const summary_type& lhs,
+    const summary_type& rhs,
+    std::index_sequence< I... >
+)
+{
+    // Each policy on its own element.
+    return summary_type(A::combine(std::get< I >(lhs), std::get< I >(rhs))...);
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // RED_BLACK_AUGMENT_CPP_
+//
\ No newline at end of file
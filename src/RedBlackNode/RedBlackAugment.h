@@ -0,0 +1,119 @@
+/**
+ *
+ * @file RedBlackAugment.h
+ *
+ * @brief Augmentation policy definitions for the red-black node class.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the monoids that a RedBlackNode can cache per sub-tree.
+ *          A policy provides a summary type, an identity summary, a function
+ *          lifting a single value into a summary and an associative function
+ *          combining two summaries (left operand first). MinAugment and
+ *          MaxAugment take their identity from std::numeric_limits, so they
+ *          only accept types that specialize it (not std::string, whose
+ *          limits would be an empty string). CompositeAugment keeps several
+ *          policies side by side in a tuple, so one tree can answer, e.g.,
+ *          the sum, minimum and count of a range in one aggregate() call.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef RED_BLACK_AUGMENT_H_
+#define RED_BLACK_AUGMENT_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <limits>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+//
+//  Class Definitions  /////////////////////////////////////////////////////////
+//
+template<class T>
+struct NoAugment
+{
+    struct summary_type {}; /**< Empty summary */
+    static constexpr bool enabled = false; /**< Summaries are not maintained */
+
+    static summary_type identity(); /**< Returns the empty summary */
+    static summary_type lift(const T&); /**< Returns the empty summary */
+    static summary_type combine(const summary_type&, const summary_type&); /**< Returns the empty summary */
+};
+
+template<class T, class S = long>
+struct SumAugment
+{
+    typedef S summary_type; /**< Sum of the values in a sub-tree */
+    static constexpr bool enabled = true; /**< Summaries are maintained */
+
+    static summary_type identity(); /**< Returns zero */
+    static summary_type lift(const T&); /**< Returns the value as a sum */
+    static summary_type combine(const summary_type&, const summary_type&); /**< Adds both sums */
+};
+
+template<class T>
+struct MinAugment
+{
+    static_assert(std::numeric_limits< T >::is_specialized, "MinAugment needs a type with numeric limits (the identity is its largest value)");
+
+    typedef T summary_type; /**< Minimum value in a sub-tree */
+    static constexpr bool enabled = true; /**< Summaries are maintained */
+
+    static summary_type identity(); /**< Returns the largest representable value */
+    static summary_type lift(const T&); /**< Returns the value */
+    static summary_type combine(const summary_type&, const summary_type&); /**< Returns the smaller value */
+};
+
+template<class T>
+struct MaxAugment
+{
+    static_assert(std::numeric_limits< T >::is_specialized, "MaxAugment needs a type with numeric limits (the identity is its smallest value)");
+
+    typedef T summary_type; /**< Maximum value in a sub-tree */
+    static constexpr bool enabled = true; /**< Summaries are maintained */
+
+    static summary_type identity(); /**< Returns the smallest representable value */
+    static summary_type lift(const T&); /**< Returns the value */
+    static summary_type combine(const summary_type&, const summary_type&); /**< Returns the larger value */
+};
+
+template<class T>
+struct CountAugment
+{
+    typedef unsigned long summary_type; /**< Number of values in a sub-tree */
+    static constexpr bool enabled = true; /**< Summaries are maintained */
+
+    static summary_type identity(); /**< Returns zero */
+    static summary_type lift(const T&); /**< Returns one */
+    static summary_type combine(const summary_type&, const summary_type&); /**< Adds both counts */
+};
+
+template<class T, class... A>
+struct CompositeAugment
+{
+    typedef std::tuple< typename A::summary_type... > summary_type; /**< Summary of every policy, in order */
+    static constexpr bool enabled = true; /**< Summaries are maintained */
+
+    static summary_type identity(); /**< Returns the identity of every policy */
+    static summary_type lift(const T&); /**< Lifts the value through every policy */
+    static summary_type combine(const summary_type&, const summary_type&); /**< Combines each policy's summaries */
+
+  private:
+    template<std::size_t... I>
+    static summary_type combine(const summary_type&, const summary_type&, std::index_sequence< I... >); /**< Combines each policy's summaries */
+};
+
+template<class T, class S = long>
+using RangeStatsAugment = CompositeAugment< T, SumAugment< T, S >, MinAugment< T >, CountAugment< T > >; /**< Sum, minimum and count in one tree */
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "RedBlackAugment.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // RED_BLACK_AUGMENT_H_
+//
\ No newline at end of file
@@ -0,0 +1,148 @@
+/**
+ *
+ * @file RedBlackKey.cpp
+ *
+ * @brief Key comparison traits implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the traits defined in RedBlackKey.h. The std::string
+ *          members are not templates, so they are defined inline.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef RED_BLACK_KEY_CPP_
+#define RED_BLACK_KEY_CPP_
+#define RED_BLACK_KEY_PREFIX_SIZE 8
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include "RedBlackKey.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the empty cache
+ *
+ * @return Empty cache
+ *
+ */
+template<typename T>
+typename RedBlackKey<T>::cache_type RedBlackKey<T>::cache(const T&)
+{
+    // Nothing to cache.
+    return cache_type();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Compares two keys with operator<
+ *
+ * @param[in] lhs
+ *            Left key.
+ *
+ * @param[in] rhs
+ *            Right key.
+ *
+ * @return Negative, zero or positive as lhs orders before, with or after rhs
+ *
+ */
+template<typename T>
+int RedBlackKey<T>::compare(const T& lhs, const cache_type&, const T& rhs, const cache_type&)
+{
+    // Compare.
+    return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Packs the first 8 bytes of the key into an integer (first byte most
+ *          significant, missing bytes zero), so integer order matches the
+ *          order of the prefixes
+ *
+ * @param[in] key
+ *            Key to cache.
+ *
+ * @return Prefix cache
+ *
+ */
+inline RedBlackKey< std::string >::cache_type RedBlackKey< std::string >::cache(const std::string& key)
+{
+    // Prefix length.
+    auto length = key.size() < RED_BLACK_KEY_PREFIX_SIZE ? key.size() : RED_BLACK_KEY_PREFIX_SIZE;
+
+    // Pack big-endian.
+    std::uint64_t prefix = 0;
+    for (std::size_t i = 0; i < RED_BLACK_KEY_PREFIX_SIZE; i++)
+    {
+        // Shift in byte (zero past the end).
+        prefix = (prefix << 8) | (i < length ? (unsigned char) key[i] : 0);
+    }
+
+    // Return cache.
+    return cache_type{
+        prefix,
+        (std::uint8_t) (key.size() > RED_BLACK_KEY_PREFIX_SIZE ? RED_BLACK_KEY_PREFIX_SIZE + 1 : key.size())
+    };
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Compares the cached prefixes; on a tie, a key that fits in the
+ *          prefix is a prefix of the other key, so the lengths decide. Only
+ *          two keys longer than the prefix need their remaining bytes read.
+ *
+ * @param[in] lhs
+ *            Left key.
+ *
+ * @param[in] lhs_cache
+ *            Cache of the left key.
+ *
+ * @param[in] rhs
+ *            Right key.
+ *
+ * @param[in] rhs_cache
+ *            Cache of the right key.
+ *
+ * @return Negative, zero or positive as lhs orders before, with or after rhs
+ *
+ */
+inline int RedBlackKey< std::string >::compare(
+    const std::string& lhs,
+    const cache_type& lhs_cache,
+    const std::string& rhs,
+    const cache_type& rhs_cache
+)
+{
+    // Prefixes differ?
+    if (lhs_cache.prefix != rhs_cache.prefix)
+    {
+        // Integer compare.
+        return lhs_cache.prefix < rhs_cache.prefix ? -1 : 1;
+    }
+
+    // Either key fits in the prefix?
+    if (lhs_cache.length <= RED_BLACK_KEY_PREFIX_SIZE || rhs_cache.length <= RED_BLACK_KEY_PREFIX_SIZE)
+    {
+        // Shorter key orders first.
+        return (int) lhs_cache.length - (int) rhs_cache.length;
+    }
+
+    // Compare remaining bytes.
+    return lhs.compare(RED_BLACK_KEY_PREFIX_SIZE, std::string::npos, rhs, RED_BLACK_KEY_PREFIX_SIZE, std::string::npos);
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#undef RED_BLACK_KEY_PREFIX_SIZE
+#endif // RED_BLACK_KEY_CPP_
+//
\ No newline at end of file
@@ -0,0 +1,63 @@
+/**
+ *
+ * @file RedBlackKey.h
+ *
+ * @brief Key comparison traits for the red-black node class.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines how a RedBlackNode compares keys. Each node stores a small
+ *          cache derived from its key next to the color bit; a comparison
+ *          consults the caches first and dereferences the stored value only
+ *          when they cannot decide. The generic traits cache nothing and use
+ *          operator<. The std::string traits cache an order-preserving 8 byte
+ *          prefix, so most comparisons are a single integer compare and keys
+ *          of up to 8 bytes are compared without touching the heap. The cache
+ *          is only a comparison aid: the key itself is still stored through
+ *          the node's value pointer, a separate allocation for every length
+ *          (there is no inline small-string storage).
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef RED_BLACK_KEY_H_
+#define RED_BLACK_KEY_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <string>
+#include <cstdint>
+//
+//  Class Definitions  /////////////////////////////////////////////////////////
+//
+template<class T>
+struct RedBlackKey
+{
+    struct cache_type {}; /**< Nothing cached */
+
+    static cache_type cache(const T&); /**< Returns the (empty) cache of a key */
+    static int compare(const T&, const cache_type&, const T&, const cache_type&); /**< Three-way comparison using operator< */
+};
+
+template<>
+struct RedBlackKey< std::string >
+{
+    struct cache_type
+    {
+        std::uint64_t prefix; /**< First 8 bytes, big-endian, zero padded */
+        std::uint8_t length; /**< Key length, capped at 9 (longer than the prefix) */
+    };
+
+    static cache_type cache(const std::string&); /**< Returns the prefix cache of a key */
+    static int compare(const std::string&, const cache_type&, const std::string&, const cache_type&); /**< Three-way comparison, reading the strings only on long prefix ties */
+};
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "RedBlackKey.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // RED_BLACK_KEY_H_
+//
\ No newline at end of file
@@ -26,13 +26,15 @@
  * @details Default initializes empty (red) node
  *
  */
-template<typename T>
-RedBlackNode<T>::RedBlackNode(std::shared_ptr< RedBlackNode< T > > parent_ptr, bool is_red)
+template<typename T, typename A>
+RedBlackNode<T, A>::RedBlackNode(std::shared_ptr< RedBlackNode< T, A > > parent_ptr, bool is_red)
     : parent_ptr_(parent_ptr),
       value_ptr_(nullptr),
       is_red_(is_red),
+      key_cache_(),
       left_child_ptr_(nullptr),
-      right_child_ptr_(nullptr) {}
+      right_child_ptr_(nullptr),
+      summary_(A::identity()) {}
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
 //
@@ -41,13 +43,15 @@ RedBlackNode<T>::RedBlackNode(std::shared_ptr< RedBlackNode< T > > parent_ptr, b
  * @details Copy-initializes node
  *
  */
-template<typename T>
-RedBlackNode<T>::RedBlackNode(const RedBlackNode<T>& origin)
+template<typename T, typename A>
+RedBlackNode<T, A>::RedBlackNode(const RedBlackNode<T, A>& origin)
     : parent_ptr_(origin.parent_ptr_),
       value_ptr_(origin.value_ptr_),
       is_red_(origin.is_red_),
+      key_cache_(origin.key_cache_),
       left_child_ptr_(origin.left_child_ptr_),
-      right_child_ptr_(origin.right_child_ptr_) {}
+      right_child_ptr_(origin.right_child_ptr_),
+      summary_(origin.summary_) {}
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
 //
@@ -56,8 +60,8 @@ RedBlackNode<T>::RedBlackNode(const RedBlackNode<T>& origin)
  * @details Destructor
  *
  */
-template<typename T>
-RedBlackNode<T>::~RedBlackNode() {}
+template<typename T, typename A>
+RedBlackNode<T, A>::~RedBlackNode() {}
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
 //
@@ -68,8 +72,8 @@ RedBlackNode<T>::~RedBlackNode() {}
  * @return Boolean value indicating if the tree is empty
  *
  */
-template<typename T>
-bool RedBlackNode<T>::empty() const
+template<typename T, typename A>
+bool RedBlackNode<T, A>::empty() const
 {
     // Empty if no value.
     return !value_ptr_;
@@ -85,8 +89,8 @@ bool RedBlackNode<T>::empty() const
  * @return Boolean value indicating whether or not the node has a parent
  *
  */
-template<typename T>
-bool RedBlackNode< T >::is_root() const
+template<typename T, typename A>
+bool RedBlackNode< T, A >::is_root() const
 {
     // Return boolean indicating whether or not the node has a parent.
     return (bool) parent_ptr_;
@@ -94,6 +98,23 @@ bool RedBlackNode< T >::is_root() const
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
 //
+/**
+ *
+ * @details Returns a boolean value indicating whether the node is red (empty
+ *          nodes are black)
+ *
+ * @return Boolean value indicating whether the node is red
+ *
+ */
+template<typename T, typename A>
+bool RedBlackNode<T, A>::is_red() const
+{
+    // Return color.
+    return is_red_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
 /**
  *
  * @details Returns a smart pointer to parent node
@@ -101,8 +122,8 @@ bool RedBlackNode< T >::is_root() const
  * @return Smart pointer to parent node
  *
  */
-template<typename T>
-std::shared_ptr< RedBlackNode< T > > RedBlackNode< T >::parent() const
+template<typename T, typename A>
+std::shared_ptr< RedBlackNode< T, A > > RedBlackNode< T, A >::parent() const
 {
     // Return pointer to parent.
     return parent_ptr_;
@@ -110,6 +131,68 @@ std::shared_ptr< RedBlackNode< T > > RedBlackNode< T >::parent() const
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
 //
+/**
+ *
+ * @details Returns a smart pointer to the root of the tree containing this
+ *          node. Rotations may move the root away from the node a caller
+ *          holds, so this walks the parent pointers to the top.
+ *
+ * @return Smart pointer to the root node
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< RedBlackNode< T, A > > RedBlackNode< T, A >::root()
+{
+    // Start here.
+    auto node_ptr = this->shared_from_this();
+
+    // Climb.
+    while (node_ptr->parent_ptr_)
+    {
+        // Advance.
+        node_ptr = node_ptr->parent_ptr_;
+    }
+
+    // Return root.
+    return node_ptr;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a smart pointer to the left child (an empty node below a
+ *          leaf, nullptr below an empty node)
+ *
+ * @return Smart pointer to left child
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< RedBlackNode< T, A > > RedBlackNode< T, A >::left_child() const
+{
+    // Return pointer to left child.
+    return left_child_ptr_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a smart pointer to the right child (an empty node below a
+ *          leaf, nullptr below an empty node)
+ *
+ * @return Smart pointer to right child
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< RedBlackNode< T, A > > RedBlackNode< T, A >::right_child() const
+{
+    // Return pointer to right child.
+    return right_child_ptr_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
 /**
  *
  * @details Returns a number indicating the current height of the tree
@@ -117,8 +200,8 @@ std::shared_ptr< RedBlackNode< T > > RedBlackNode< T >::parent() const
  * @return Integer indicating the current height of the tree
  *
  */
-template<typename T>
-unsigned int RedBlackNode<T>::height() const
+template<typename T, typename A>
+unsigned int RedBlackNode<T, A>::height() const
 {
     // Empty?
     if (empty())
@@ -143,8 +226,8 @@ unsigned int RedBlackNode<T>::height() const
  * @return Integer indicating the current number of nodes in the tree
  *
  */
-template<typename T>
-unsigned int RedBlackNode<T>::total_nodes() const
+template<typename T, typename A>
+unsigned int RedBlackNode<T, A>::total_nodes() const
 {
     // Empty?
     if (empty())
@@ -166,8 +249,8 @@ unsigned int RedBlackNode<T>::total_nodes() const
  * @return Returns the value of the node
  *
  */
-template<typename T>
-T RedBlackNode<T>::value() const
+template<typename T, typename A>
+T RedBlackNode<T, A>::value() const
 {
     // Return root value.
     return *value_ptr_;
@@ -177,16 +260,99 @@ T RedBlackNode<T>::value() const
 //
 /**
  *
- * @details Clears the tree
+ * @details Returns the cached summary of every value in the tree in which
+ *          this node is the root
+ *
+ * @return Summary of the sub-tree
+ *
+ */
+template<typename T, typename A>
+typename RedBlackNode<T, A>::summary_type RedBlackNode<T, A>::summary() const
+{
+    // Return cached summary.
+    return summary_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of every value v in the tree (where this node
+ *          is the root) with lower <= v <= upper. Descends to the node where
+ *          the bounds split and then follows one path per bound, combining
+ *          the cached summaries of the sub-trees hanging inside the range, so
+ *          the query runs in O(log n).
+ *
+ * @param[in] lower
+ *            Inclusive lower bound of the range.
+ *
+ * @param[in] upper
+ *            Inclusive upper bound of the range.
+ *
+ * @return Summary of the values in the range
+ *
+ */
+template<typename T, typename A>
+typename RedBlackNode<T, A>::summary_type RedBlackNode<T, A>::aggregate(const T& lower, const T& upper) const
+{
+    // Empty?
+    if (empty())
+    {
+        // Nothing in range.
+        return A::identity();
+    }
+
+    // Range entirely right?
+    else if (*value_ptr_ < lower)
+    {
+        // Forward.
+        return right_child_ptr_->aggregate(lower, upper);
+    }
+
+    // Range entirely left?
+    else if (upper < *value_ptr_)
+    {
+        // Forward.
+        return left_child_ptr_->aggregate(lower, upper);
+    }
+
+    // Split node.
+    return A::combine(
+        A::combine(left_child_ptr_->aggregate_from(lower), A::lift(*value_ptr_)),
+        right_child_ptr_->aggregate_to(upper)
+    );
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Clears the tree. The sub-trees are cleared and unlinked first, since
+ *          their parent links would otherwise keep them alive.
  *
  */
-template<typename T>
-void RedBlackNode<T>::clear()
+template<typename T, typename A>
+void RedBlackNode<T, A>::clear()
 {
+    // Release sub-trees.
+    for (auto child_ptr : {left_child_ptr_.get(), right_child_ptr_.get()})
+    {
+        // Present?
+        if (child_ptr)
+        {
+            // Clear and unlink.
+            child_ptr->clear();
+            child_ptr->parent_ptr_ = nullptr;
+        }
+    }
+
     // Reset all pointers.
     value_ptr_ = nullptr;
     left_child_ptr_ = nullptr;
     right_child_ptr_ = nullptr;
+
+    // Reset summary.
+    summary_ = A::identity();
 }
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
@@ -202,11 +368,31 @@ void RedBlackNode<T>::clear()
  * @return Boolean value that represents the results of the search.
  *
  */
-template<typename T>
-bool RedBlackNode<T>::contains(T key) const
+template<typename T, typename A>
+bool RedBlackNode<T, A>::contains(T key) const
 {
     // Return search result.
-    return fetch_descendant(key);
+    return (bool) fetch_descendant(key, RedBlackKey< T >::cache(key));
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Searches the tree for the greatest value not greater than the key
+ *
+ * @param[in] key
+ *            Value used for comparison in search.
+ *
+ * @return Smart pointer to the stored value, or nullptr if every value is
+ *         greater than the key
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< T > RedBlackNode<T, A>::floor(const T& key) const
+{
+    // Forward with key cache.
+    return floor_cached(key, RedBlackKey< T >::cache(key));
 }
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
@@ -220,8 +406,8 @@ bool RedBlackNode<T>::contains(T key) const
  *            Function to execute with each item.
  *
  */
-template<typename T>
-void RedBlackNode<T>::each_preorder(std::function< void(std::shared_ptr< T >) > iteratee)
+template<typename T, typename A>
+void RedBlackNode<T, A>::each_preorder(std::function< void(std::shared_ptr< T >) > iteratee)
 {
     // Empty?
     if (empty())
@@ -249,8 +435,8 @@ void RedBlackNode<T>::each_preorder(std::function< void(std::shared_ptr< T >) >
  *            Function to execute with each item.
  *
  */
-template<typename T>
-void RedBlackNode<T>::each_inorder(std::function< void(std::shared_ptr< T >) > iteratee)
+template<typename T, typename A>
+void RedBlackNode<T, A>::each_inorder(std::function< void(std::shared_ptr< T >) > iteratee)
 {
     // Empty?
     if (empty())
@@ -280,8 +466,8 @@ void RedBlackNode<T>::each_inorder(std::function< void(std::shared_ptr< T >) > i
  *            Function to execute with each item.
  *
  */
-template<typename T>
-void RedBlackNode<T>::each_postorder(std::function< void(std::shared_ptr< T >) > iteratee)
+template<typename T, typename A>
+void RedBlackNode<T, A>::each_postorder(std::function< void(std::shared_ptr< T >) > iteratee)
 {
     // Empty?
     if (empty())
@@ -310,21 +496,173 @@ void RedBlackNode<T>::each_postorder(std::function< void(std::shared_ptr< T >) >
  *            Item to add to tree.
  *
  */
-template<typename T>
-bool RedBlackNode<T>::add(const T& key)
+template<typename T, typename A>
+bool RedBlackNode<T, A>::add(const T& key)
+{
+    // Forward with key cache.
+    return add_cached(key, RedBlackKey< T >::cache(key));
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Adds the item as a red leaf of the tree where this node is the
+ *          root, like add() but without the fix-up; the caller owns the
+ *          "red" violation it may leave and passes the node to fixup_step()
+ *
+ * @param[in] key
+ *            Value to add.
+ *
+ * @return Smart pointer to the new node
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< RedBlackNode< T, A > > RedBlackNode<T, A>::add_unbalanced(const T& key)
+{
+    // Descend to the empty node for the key (raw pointers, no reference counting).
+    auto key_cache = RedBlackKey< T >::cache(key);
+    RedBlackNode< T, A >* cursor_ptr = this;
+    while (!cursor_ptr->empty())
+    {
+        // Left (ties) or right.
+        cursor_ptr = RedBlackKey< T >::compare(key, key_cache, *cursor_ptr->value_ptr_, cursor_ptr->key_cache_) <= 0
+            ? cursor_ptr->left_child_ptr_.get()
+            : cursor_ptr->right_child_ptr_.get();
+    }
+    auto node_ptr = cursor_ptr->shared_from_this();
+
+    // Fill as a red leaf.
+    node_ptr->value_ptr_ = std::make_shared< T >(key);
+    node_ptr->key_cache_ = key_cache;
+    node_ptr->is_red_ = true;
+    node_ptr->left_child_ptr_ = std::make_shared< RedBlackNode< T, A > >(node_ptr, false);
+    node_ptr->right_child_ptr_ = std::make_shared< RedBlackNode< T, A > >(node_ptr, false);
+
+    // Update summaries along the insertion path.
+    node_ptr->propagate_summary();
+
+    // Return new node.
+    return node_ptr;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Performs one constant-time step of the insertion fix-up at this
+ *          node, tolerating other violations elsewhere in the tree. A red
+ *          uncle is recolored and the grandparent queued instead of fixed
+ *          recursively; a red grandparent means the parent's violation is
+ *          fixed first, so both are queued (parent first). Follow-up nodes go
+ *          to the front of the queue. Queued nodes that are no longer in
+ *          violation are skipped when stepped.
+ *
+ * @param[in,out] pending
+ *                Queue of nodes that may be in violation (any container
+ *                with push_front).
+ *
+ */
+template<typename T, typename A>
+template<typename Q>
+void RedBlackNode<T, A>::fixup_step(Q& pending)
+{
+    // Not red (resolved already)?
+    if (empty() || !is_red_)
+    {
+        // Nothing to do.
+        return;
+    }
+
+    // Root?
+    if (!parent_ptr_)
+    {
+        // Make black.
+        is_red_ = false;
+        return;
+    }
+
+    // Black parent?
+    if (!parent_ptr_->is_red_)
+    {
+        // No violation.
+        return;
+    }
+
+    // Red root parent?
+    auto grandparent_ptr = parent_ptr_->parent_ptr_;
+    if (!grandparent_ptr)
+    {
+        // Make black.
+        parent_ptr_->is_red_ = false;
+        return;
+    }
+
+    // Red grandparent?
+    if (grandparent_ptr->is_red_)
+    {
+        // Fix parent first, then this node.
+        pending.push_front(this->shared_from_this());
+        pending.push_front(parent_ptr_);
+        return;
+    }
+
+    // Get uncle.
+    auto uncle_ptr = grandparent_ptr->left_child_ptr_ == parent_ptr_ ? grandparent_ptr->right_child_ptr_ : grandparent_ptr->left_child_ptr_;
+
+    // Red uncle?
+    if (uncle_ptr->is_red_)
+    {
+        // Push "red" violation up the tree (one level per step).
+        parent_ptr_->is_red_ = false;
+        uncle_ptr->is_red_ = false;
+        grandparent_ptr->is_red_ = true;
+        pending.push_front(grandparent_ptr);
+    }
+
+    // Black uncle.
+    else
+    {
+        // Rotate into place.
+        restructure();
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Adds item with the value of the key parameter to the correct
+ *          position in the tree and restructures/repaints the tree to maintain
+ *          balance. The key cache is computed once by add() and reused at
+ *          every level.
+ *
+ * @param[in] key
+ *            Item to add to tree.
+ *
+ * @param[in] key_cache
+ *            Key cache of the item.
+ *
+ */
+template<typename T, typename A>
+bool RedBlackNode<T, A>::add_cached(const T& key, const key_cache_type& key_cache)
 {
     // Empty?
     if (empty())
     {
         // Add node.
         value_ptr_ = std::make_shared< T >(key);
+        key_cache_ = key_cache;
 
         // Make red.
         is_red_ = true;
 
         // Default-initialize child nodes.
-        left_child_ptr_ = std::make_shared< RedBlackNode< T > >(this->shared_from_this(), false);
-        right_child_ptr_ = std::make_shared< RedBlackNode< T > >(this->shared_from_this(), false);
+        left_child_ptr_ = std::make_shared< RedBlackNode< T, A > >(this->shared_from_this(), false);
+        right_child_ptr_ = std::make_shared< RedBlackNode< T, A > >(this->shared_from_this(), false);
+
+        // Update summaries along the insertion path.
+        propagate_summary();
 
         // Fix-up.
         fixup();
@@ -334,17 +672,17 @@ bool RedBlackNode<T>::add(const T& key)
     }
 
     // Left sub-tree?
-    else if (key <= *value_ptr_)
+    else if (RedBlackKey< T >::compare(key, key_cache, *value_ptr_, key_cache_) <= 0)
     {
         // Add left.
-        return left_child_ptr_->add(key);
+        return left_child_ptr_->add_cached(key, key_cache);
     }
     
     // Right sub-tree.
     else
     {
         // Add right.
-        return right_child_ptr_->add(key);
+        return right_child_ptr_->add_cached(key, key_cache);
     }
 }
 //
@@ -352,144 +690,1015 @@ bool RedBlackNode<T>::add(const T& key)
 //
 /**
  *
- * @details Removes item specified by the value of key from the tree.
- *          (TODO: IMPLEMENT)
+ * @details Removes item specified by the value of key from the tree and
+ *          restructures/repaints the tree to maintain balance. Values move
+ *          between nodes instead of nodes being unlinked, so the node the
+ *          caller holds stays in the tree (though it may no longer be the
+ *          root; see root()).
  *
  * @param[in] key
  *            Item to remove from the tree.
  *
  */
-template<typename T>
-bool RedBlackNode<T>::remove(const T& key) { return false; }
-//
-//  Class Member Implementation  ///////////////////////////////////////////////
-//
-/**
- *
- * @details Searches for node with specified value in tree and returns a smart
- *          pointer to it.
- *
- * @param[in] key
- *            Item to search for in the tree.
- *
- */
-template<typename T>
-std::shared_ptr< RedBlackNode< T > > RedBlackNode<T>::fetch_descendant(T key)
+template<typename T, typename A>
+bool RedBlackNode<T, A>::remove(const T& key)
 {
-    // Is empty or equal?
-    if (empty())
+    // Find node.
+    auto target_ptr = fetch_descendant(key, RedBlackKey< T >::cache(key));
+
+    // Not found?
+    if (!target_ptr)
     {
-        // No match.
-        return nullptr;
+        // Return failure.
+        return false;
     }
-    else if (key == *value_ptr_)
+
+    // Two children?
+    if (!target_ptr->left_child_ptr_->empty() && !target_ptr->right_child_ptr_->empty())
     {
-        // Return this.
-        return this;
+        // Find in-order successor.
+        auto successor_ptr = target_ptr->right_child_ptr_;
+        while (!successor_ptr->left_child_ptr_->empty())
+        {
+            // Advance.
+            successor_ptr = successor_ptr->left_child_ptr_;
+        }
+
+        // Take successor value and remove successor instead.
+        target_ptr->value_ptr_ = successor_ptr->value_ptr_;
+        target_ptr->key_cache_ = successor_ptr->key_cache_;
+        target_ptr = successor_ptr;
     }
-    // Is in left tree?
-    else if (key < *value_ptr_)
+
+    // Get only child (if any).
+    auto child_ptr = target_ptr->left_child_ptr_->empty() ? target_ptr->right_child_ptr_ : target_ptr->left_child_ptr_;
+
+    // One child?
+    if (!child_ptr->empty())
     {
-        // Return result from left tree.
-        return left_child_ptr_->value() == key ? left_child_ptr_->value() : left_child_ptr_->fetch_descendant(key);
+        // Child must be a red leaf, so take its value and empty it.
+        target_ptr->value_ptr_ = child_ptr->value_ptr_;
+        target_ptr->key_cache_ = child_ptr->key_cache_;
+        child_ptr->clear();
+        child_ptr->is_red_ = false;
+
+        // Update summaries along the removal path.
+        target_ptr->propagate_summary();
+
+        // Return success.
+        return true;
     }
-    // In right tree.
-    else
+
+    // Save color.
+    auto was_red = target_ptr->is_red_;
+
+    // Leaf becomes an empty (black) node.
+    target_ptr->clear();
+    target_ptr->is_red_ = false;
+
+    // Update summaries along the removal path.
+    target_ptr->propagate_summary();
+
+    // Lost a black node?
+    if (!was_red)
     {
-        // Return result from right tree.
-        return right_child_ptr_->value() == key ? right_child_ptr_->value() : right_child_ptr_->fetch_descendant(key);
+        // Fix-up.
+        target_ptr->remove_fixup();
     }
+
+    // Return success.
+    return true;
 }
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
 //
 /**
  *
- * @details Balances tree (after recolor).
+ * @details Replaces the contents of the tree with the (sorted) values, building
+ *          a balanced tree in O(n) instead of adding one value at a time. Every
+ *          level is full except possibly the deepest, which is painted red, so
+ *          the result satisfies the red-black invariants without any fix-up.
+ *          Must be called on the root.
+ *
+ * @param[in] values
+ *            Values to store, in non-decreasing order.
  *
  */
-template<typename T>
-void RedBlackNode<T>::fixup()
+template<typename T, typename A>
+void RedBlackNode<T, A>::assign_sorted(const std::vector< T >& values)
 {
-    // Root?
-    if (!parent_ptr_)
+    // Drop current contents.
+    clear();
+    is_red_ = false;
+
+    // Nothing to add?
+    if (values.empty())
     {
-        // Make black.
-        is_red_ = false;
+        // Done.
+        return;
     }
 
-    // "Red" violation (node and parent are both red).
-    else if (is_red_ && parent_ptr_->is_red_)
+    // Count full levels.
+    unsigned int full_levels = 0;
+    while (((size_t) 2 << full_levels) - 1 <= values.size())
     {
-        // Get grandparent.
-        auto grandparent_ptr = parent_ptr_->parent_ptr_;
-
-        // Get uncle.
-        auto uncle_ptr = grandparent_ptr->left_child_ptr_ == parent_ptr_ ? grandparent_ptr->right_child_ptr_ : grandparent_ptr->left_child_ptr_;
-
-        // Left child?
-        auto is_left_child = parent_ptr_->left_child_ptr_.get() == this;
-
-        // Red uncle?
-        if (uncle_ptr && uncle_ptr->is_red_)
-        {
-            // Push "red" violation up the tree.
-            parent_ptr_->is_red_ = false;
-            uncle_ptr->is_red_ = false;
-            grandparent_ptr->is_red_ = true;
-
-            // Fixup at grandparent.
-            grandparent_ptr->fixup();
-        }
-
-        // No uncle or uncle is black.
-        else
-        {
-            // Outer child (left child of left child or right child of right child)?
-            if (
-                (is_left_child && grandparent_ptr->left_child_ptr_ == parent_ptr_) ||
-                (!is_left_child && grandparent_ptr->right_child_ptr_ == parent_ptr_)
-            )
-            {
-                // Color parent black and grandparent red.
-                parent_ptr_->is_red_ = false;
-                grandparent_ptr->is_red_ = true;
-
-                // Rotate inward.
-                is_left_child ? parent_ptr_->rotate_right() : parent_ptr_->rotate_left();
-            }
-
-            // Inner child.
-            else
-            {
-                // Rotate outward about this node.
-                is_left_child ? rotate_right() : rotate_left();
-
-                // Fix as if case #2.
-                is_red_ = false;
-                parent_ptr_->is_red_ = true;
-
-                // Rotate inward about this node.
-                parent_ptr_->left_child_ptr_.get() == this ? rotate_right() : rotate_left();
-            }
-        }
-
+        // Advance.
+        ++full_levels;
     }
+
+    // Partial level below the full ones (if any) is red.
+    build_sorted(values, 0, values.size(), 0, full_levels, 0);
 }
 //
 //  Class Member Implementation  ///////////////////////////////////////////////
 //
 /**
  *
- * @details Rotate left about this node.
+ * @details Adds each distinct value of the range to the tree where this node
+ *          is the root. The batch is sorted and deduped on worker threads. A
+ *          small batch is added one value at a time in sorted order, and an
+ *          empty tree is built balanced on worker threads. Otherwise the top
+ *          levels of the tree are split off, leaving disjoint sub-trees and the
+ *          pivot nodes between them. Each sub-tree is detached and takes its
+ *          part of the batch on its own thread, so its fix-ups never leave it.
+ *          The sub-trees are then joined back through the pivot nodes, which
+ *          costs O(log n) per sub-tree. No node is discarded and the cost
+ *          grows with the batch, not the tree. The root may change, so callers
+ *          re-acquire it with root().
+ *
+ * @param[in] first
+ *            Iterator to the first value of the batch.
+ *
+ * @param[in] last
+ *            Iterator one past the last value of the batch.
+ *
+ * @param[in] threads
+ *            Number of worker threads (0 for the hardware concurrency).
+ *
+ * @return Number of values added
+ *
+ * @exception std::invalid_argument
+ *            Node is not the root.
  *
  */
-template<typename T>
-void RedBlackNode<T>::rotate_left()
+template<typename T, typename A>
+template<typename I>
+std::size_t RedBlackNode<T, A>::insert_batch(I first, I last, unsigned int threads)
 {
-    // Save grandparent.
-    auto grandparent_ptr = parent_ptr_->parent_ptr_;
-
+    // Not the root?
+    if (parent_ptr_)
+    {
+        // Ancestors would miss the new values.
+        throw std::invalid_argument("insert_batch must be called on the root");
+    }
+
+    // Worker count.
+    if (threads == 0)
+    {
+        // Use hardware.
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Sort and dedupe batch.
+    std::vector< T > batch(first, last);
+    sort_unique(batch, threads);
+
+    // Split depth for the worker count.
+    unsigned int split_depth = 0;
+    while (((std::size_t) 1 << split_depth) < threads)
+    {
+        // Advance.
+        ++split_depth;
+    }
+
+    // Small batch?
+    if (batch.size() < RED_BLACK_BATCH_MIN_PARALLEL)
+    {
+        // Add in order.
+        std::size_t count = 0;
+        auto root_ptr = this->shared_from_this();
+        for (const auto& value : batch)
+        {
+            // Add and update root.
+            count += root_ptr->add(value);
+            root_ptr = root_ptr->root();
+        }
+
+        // Return count.
+        return count;
+    }
+
+    // Empty tree?
+    if (empty())
+    {
+        // Count full levels.
+        unsigned int full_levels = 0;
+        while (((size_t) 2 << full_levels) - 1 <= batch.size())
+        {
+            // Advance.
+            ++full_levels;
+        }
+
+        // Build balanced.
+        is_red_ = false;
+        build_sorted(batch, 0, batch.size(), 0, full_levels, split_depth);
+
+        // Return count.
+        return batch.size();
+    }
+
+    // Split tree into disjoint sub-trees along its top pivots.
+    std::vector< std::shared_ptr< RedBlackNode< T, A > > > pieces;
+    std::vector< std::shared_ptr< RedBlackNode< T, A > > > pivots;
+    collect_pieces(split_depth, pieces, pivots);
+
+    // Batch part of each sub-tree (values equal to a pivot go left, as in add).
+    std::vector< std::size_t > bounds(pieces.size() + 1, batch.size());
+    bounds[0] = 0;
+    for (std::size_t i = 0; i < pivots.size(); i++)
+    {
+        // Upper bound of pivot.
+        bounds[i + 1] = std::upper_bound(batch.begin(), batch.end(), *pivots[i]->value_ptr_) - batch.begin();
+    }
+
+    // Detach sub-trees as black-rooted trees.
+    for (auto& piece_ptr : pieces)
+    {
+        // Unlink.
+        piece_ptr->parent_ptr_ = nullptr;
+        piece_ptr->is_red_ = false;
+    }
+
+    // Add each part to its sub-tree.
+    std::vector< std::size_t > counts(pieces.size(), 0);
+    run_parallel(pieces.size(), [&] (std::size_t i) {
+        auto root_ptr = pieces[i];
+        for (auto index = bounds[i]; index < bounds[i + 1]; index++)
+        {
+            // Add and update root.
+            counts[i] += root_ptr->add(batch[index]);
+            root_ptr = root_ptr->root();
+        }
+        pieces[i] = root_ptr;
+    });
+
+    // Join sub-trees through the pivots.
+    auto root_ptr = pieces[0];
+    for (std::size_t i = 0; i < pivots.size(); i++)
+    {
+        // Join next.
+        root_ptr = join(root_ptr, pivots[i], pieces[i + 1]);
+    }
+
+    // Return count.
+    std::size_t count = 0;
+    for (auto piece_count : counts)
+    {
+        // Sum.
+        count += piece_count;
+    }
+    return count;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Searches for node with specified value in tree and returns a smart
+ *          pointer to it.
+ *
+ * @param[in] key
+ *            Item to search for in the tree.
+ *
+ * @param[in] key_cache
+ *            Key cache of the item.
+ *
+ * @return Smart pointer to the matching node or nullptr
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< RedBlackNode< T, A > > RedBlackNode<T, A>::fetch_descendant(const T& key, const key_cache_type& key_cache) const
+{
+    // Is empty?
+    if (empty())
+    {
+        // No match.
+        return nullptr;
+    }
+
+    // Compare.
+    auto order = RedBlackKey< T >::compare(key, key_cache, *value_ptr_, key_cache_);
+
+    // Is equal?
+    if (order == 0)
+    {
+        // Return this.
+        return std::const_pointer_cast< RedBlackNode< T, A > >(this->shared_from_this());
+    }
+    // Is in left tree?
+    else if (order < 0)
+    {
+        // Return result from left tree.
+        return left_child_ptr_->fetch_descendant(key, key_cache);
+    }
+    // In right tree.
+    else
+    {
+        // Return result from right tree.
+        return right_child_ptr_->fetch_descendant(key, key_cache);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Searches the tree for the greatest value not greater than the key
+ *
+ * @param[in] key
+ *            Value used for comparison in search.
+ *
+ * @param[in] key_cache
+ *            Key cache of the value.
+ *
+ * @return Smart pointer to the stored value (or nullptr)
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< T > RedBlackNode<T, A>::floor_cached(const T& key, const key_cache_type& key_cache) const
+{
+    // Empty?
+    if (empty())
+    {
+        // No match.
+        return nullptr;
+    }
+
+    // Compare.
+    auto order = RedBlackKey< T >::compare(key, key_cache, *value_ptr_, key_cache_);
+
+    // Exact match?
+    if (order == 0)
+    {
+        // Return this value.
+        return value_ptr_;
+    }
+
+    // Smaller than this value?
+    else if (order < 0)
+    {
+        // Floor is in left tree (if anywhere).
+        return left_child_ptr_->floor_cached(key, key_cache);
+    }
+
+    // Prefer a closer value from the right tree.
+    auto right_floor_ptr = right_child_ptr_->floor_cached(key, key_cache);
+    return right_floor_ptr ? right_floor_ptr : value_ptr_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of every value not less than the lower bound in
+ *          the tree where this node is the root. Follows a single path.
+ *
+ * @param[in] lower
+ *            Inclusive lower bound.
+ *
+ * @return Summary of the values at or above the bound
+ *
+ */
+template<typename T, typename A>
+typename RedBlackNode<T, A>::summary_type RedBlackNode<T, A>::aggregate_from(const T& lower) const
+{
+    // Empty?
+    if (empty())
+    {
+        // Nothing in range.
+        return A::identity();
+    }
+
+    // Below bound?
+    else if (*value_ptr_ < lower)
+    {
+        // Only right sub-tree can be in range.
+        return right_child_ptr_->aggregate_from(lower);
+    }
+
+    // Right sub-tree is entirely in range.
+    return A::combine(
+        A::combine(left_child_ptr_->aggregate_from(lower), A::lift(*value_ptr_)),
+        right_child_ptr_->summary_
+    );
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of every value not greater than the upper bound
+ *          in the tree where this node is the root. Follows a single path.
+ *
+ * @param[in] upper
+ *            Inclusive upper bound.
+ *
+ * @return Summary of the values at or below the bound
+ *
+ */
+template<typename T, typename A>
+typename RedBlackNode<T, A>::summary_type RedBlackNode<T, A>::aggregate_to(const T& upper) const
+{
+    // Empty?
+    if (empty())
+    {
+        // Nothing in range.
+        return A::identity();
+    }
+
+    // Above bound?
+    else if (upper < *value_ptr_)
+    {
+        // Only left sub-tree can be in range.
+        return left_child_ptr_->aggregate_to(upper);
+    }
+
+    // Left sub-tree is entirely in range.
+    return A::combine(
+        A::combine(left_child_ptr_->summary_, A::lift(*value_ptr_)),
+        right_child_ptr_->aggregate_to(upper)
+    );
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Fills this (empty) node with the middle value of the slice and
+ *          builds both halves below it. Sibling sub-trees differ in size by at
+ *          most one, so all empty leaves end up on the last two levels.
+ *
+ * @param[in] values
+ *            Values to store, in non-decreasing order.
+ *
+ * @param[in] first
+ *            Index of the first value of the slice.
+ *
+ * @param[in] last
+ *            Index one past the last value of the slice.
+ *
+ * @param[in] depth
+ *            Depth of this node.
+ *
+ * @param[in] red_depth
+ *            Depth at which nodes are painted red.
+ *
+ * @param[in] parallel_depth
+ *            Depth above which the left half is built on a new thread.
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::build_sorted(
+    const std::vector< T >& values,
+    size_t first,
+    size_t last,
+    unsigned int depth,
+    unsigned int red_depth,
+    unsigned int parallel_depth
+)
+{
+    // Middle of slice.
+    auto middle = first + (last - first) / 2;
+
+    // Add node.
+    value_ptr_ = std::make_shared< T >(values[middle]);
+    key_cache_ = RedBlackKey< T >::cache(values[middle]);
+    is_red_ = depth == red_depth;
+
+    // Default-initialize child nodes.
+    left_child_ptr_ = std::make_shared< RedBlackNode< T, A > >(this->shared_from_this(), false);
+    right_child_ptr_ = std::make_shared< RedBlackNode< T, A > >(this->shared_from_this(), false);
+
+    // Build left half (on its own thread near the top).
+    std::thread worker;
+    if (first < middle)
+    {
+        // Build.
+        auto build_left = [&] {
+            left_child_ptr_->build_sorted(values, first, middle, depth + 1, red_depth, parallel_depth);
+        };
+
+        // Spawn or recurse.
+        if (depth < parallel_depth)
+        {
+            // Spawn.
+            worker = std::thread(build_left);
+        }
+        else
+        {
+            // Recurse.
+            build_left();
+        }
+    }
+
+    // Build right half.
+    if (middle + 1 < last)
+    {
+        // Recurse.
+        right_child_ptr_->build_sorted(values, middle + 1, last, depth + 1, red_depth, parallel_depth);
+    }
+
+    // Wait for left half.
+    if (worker.joinable())
+    {
+        // Join.
+        worker.join();
+    }
+
+    // Update summary.
+    refresh_summary();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Splits the tree in which this node is the root into the disjoint
+ *          sub-trees at the given depth (or shallower empty nodes) and the
+ *          pivot nodes between them, both in order
+ *
+ * @param[in] depth
+ *            Levels left to descend.
+ *
+ * @param[out] pieces
+ *            Sub-trees, one more than the pivots.
+ *
+ * @param[out] pivots
+ *            Nodes above the sub-trees.
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::collect_pieces(
+    unsigned int depth,
+    std::vector< std::shared_ptr< RedBlackNode< T, A > > >& pieces,
+    std::vector< std::shared_ptr< RedBlackNode< T, A > > >& pivots
+)
+{
+    // Deep enough (or empty)?
+    if (depth == 0 || empty())
+    {
+        // Sub-tree.
+        pieces.push_back(this->shared_from_this());
+        return;
+    }
+
+    // Left, pivot, right.
+    left_child_ptr_->collect_pieces(depth - 1, pieces, pivots);
+    pivots.push_back(this->shared_from_this());
+    right_child_ptr_->collect_pieces(depth - 1, pieces, pivots);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Counts the black nodes on the leftmost path; a tree of black
+ *          height b holds at least 2^b - 1 values
+ *
+ * @return Black height
+ *
+ */
+template<typename T, typename A>
+unsigned int RedBlackNode<T, A>::black_height() const
+{
+    // Walk left.
+    unsigned int count = 0;
+    for (auto node_ptr = this; !node_ptr->empty(); node_ptr = node_ptr->left_child_ptr_.get())
+    {
+        // Count black.
+        count += !node_ptr->is_red_;
+    }
+
+    // Return count.
+    return count;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Joins two detached, black-rooted trees through a pivot node whose
+ *          value orders between them. With equal black heights the pivot
+ *          becomes the black root. Otherwise it is linked in red in place of
+ *          the first black node of matching black height on the taller tree's
+ *          inner spine and fixed up, in O(log n).
+ *
+ * @param[in] left_ptr
+ *            Root of the tree of smaller values.
+ *
+ * @param[in] pivot_ptr
+ *            Node to link (its old links are overwritten).
+ *
+ * @param[in] right_ptr
+ *            Root of the tree of larger values.
+ *
+ * @return Smart pointer to the root of the joined tree
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< RedBlackNode< T, A > > RedBlackNode<T, A>::join(
+    std::shared_ptr< RedBlackNode< T, A > > left_ptr,
+    std::shared_ptr< RedBlackNode< T, A > > pivot_ptr,
+    std::shared_ptr< RedBlackNode< T, A > > right_ptr
+)
+{
+    // Black heights.
+    auto left_height = left_ptr->black_height();
+    auto right_height = right_ptr->black_height();
+
+    // Equal?
+    if (left_height == right_height)
+    {
+        // Pivot becomes the root.
+        pivot_ptr->parent_ptr_ = nullptr;
+        pivot_ptr->is_red_ = false;
+        pivot_ptr->left_child_ptr_ = left_ptr;
+        pivot_ptr->right_child_ptr_ = right_ptr;
+        left_ptr->parent_ptr_ = pivot_ptr;
+        right_ptr->parent_ptr_ = pivot_ptr;
+        pivot_ptr->refresh_summary();
+
+        // Return root.
+        return pivot_ptr;
+    }
+
+    // Walk the taller tree's inner spine to a black node of matching height.
+    auto is_left_taller = left_height > right_height;
+    auto cursor_ptr = is_left_taller ? left_ptr : right_ptr;
+    auto height = std::max(left_height, right_height);
+    auto target = std::min(left_height, right_height);
+    while ((!cursor_ptr->empty() && cursor_ptr->is_red_) || height > target)
+    {
+        // Descend.
+        height -= !cursor_ptr->is_red_;
+        cursor_ptr = is_left_taller ? cursor_ptr->right_child_ptr_ : cursor_ptr->left_child_ptr_;
+    }
+
+    // Pivot takes the node's place.
+    auto parent_ptr = cursor_ptr->parent_ptr_;
+    (is_left_taller ? parent_ptr->right_child_ptr_ : parent_ptr->left_child_ptr_) = pivot_ptr;
+    pivot_ptr->parent_ptr_ = parent_ptr;
+    pivot_ptr->is_red_ = true;
+    pivot_ptr->left_child_ptr_ = is_left_taller ? cursor_ptr : left_ptr;
+    pivot_ptr->right_child_ptr_ = is_left_taller ? right_ptr : cursor_ptr;
+    pivot_ptr->left_child_ptr_->parent_ptr_ = pivot_ptr;
+    pivot_ptr->right_child_ptr_->parent_ptr_ = pivot_ptr;
+
+    // Update summaries and re-balance.
+    pivot_ptr->propagate_summary();
+    pivot_ptr->fixup();
+
+    // Return root.
+    return pivot_ptr->root();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Sorts each chunk of the values on its own thread, merges chunk
+ *          pairs in parallel rounds and removes duplicates
+ *
+ * @param[in,out] values
+ *            Values to sort.
+ *
+ * @param[in] threads
+ *            Number of chunks.
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::sort_unique(std::vector< T >& values, unsigned int threads)
+{
+    // Chunks (one if the batch is small).
+    std::size_t chunks = values.size() < RED_BLACK_BATCH_MIN_PARALLEL ? 1 : threads;
+    auto chunk_size = (values.size() + chunks - 1) / chunks;
+    auto chunk_at = [&] (std::size_t i) {
+        return values.begin() + std::min(values.size(), i * chunk_size);
+    };
+
+    // Sort chunks.
+    run_parallel(chunks, [&] (std::size_t i) {
+        std::sort(chunk_at(i), chunk_at(i + 1));
+    });
+
+    // Merge neighbouring runs.
+    for (std::size_t width = 1; width < chunks; width *= 2)
+    {
+        // Merge pairs.
+        run_parallel((chunks + 2 * width - 1) / (2 * width), [&] (std::size_t i) {
+            auto low = i * 2 * width;
+            std::inplace_merge(chunk_at(low), chunk_at(std::min(chunks, low + width)), chunk_at(std::min(chunks, low + 2 * width)));
+        });
+    }
+
+    // Dedupe.
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Runs the task once for every index, each on its own thread (the
+ *          last on the calling thread), and waits for all of them
+ *
+ * @param[in] count
+ *            Number of indices.
+ *
+ * @param[in] task
+ *            Function to execute with each index.
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::run_parallel(std::size_t count, std::function< void(std::size_t) > task)
+{
+    // Nothing to do?
+    if (count == 0)
+    {
+        // Done.
+        return;
+    }
+
+    // Spawn.
+    std::vector< std::thread > workers;
+    for (std::size_t i = 0; i + 1 < count; i++)
+    {
+        // Worker.
+        workers.emplace_back(task, i);
+    }
+
+    // Last on this thread.
+    task(count - 1);
+
+    // Join.
+    for (auto& worker : workers)
+    {
+        // Wait.
+        worker.join();
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Recomputes the cached summary from the value and the (already up to
+ *          date) summaries of the children.
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::refresh_summary()
+{
+    // Empty?
+    if (empty())
+    {
+        // Reset.
+        summary_ = A::identity();
+
+        // Done.
+        return;
+    }
+
+    // Combine in order.
+    summary_ = A::combine(
+        A::combine(left_child_ptr_->summary_, A::lift(*value_ptr_)),
+        right_child_ptr_->summary_
+    );
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Recomputes the cached summaries from this node up to the root after
+ *          the set of values below this node changed.
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::propagate_summary()
+{
+    // Nothing cached?
+    if (!A::enabled)
+    {
+        // Abort.
+        return;
+    }
+
+    // Update this node.
+    refresh_summary();
+
+    // Update ancestors.
+    for (auto ancestor_ptr = parent_ptr_; ancestor_ptr; ancestor_ptr = ancestor_ptr->parent_ptr_)
+    {
+        // Update.
+        ancestor_ptr->refresh_summary();
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Balances tree (after recolor).
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::fixup()
+{
+    // Root?
+    if (!parent_ptr_)
+    {
+        // Make black.
+        is_red_ = false;
+    }
+
+    // "Red" violation (node and parent are both red).
+    else if (is_red_ && parent_ptr_->is_red_)
+    {
+        // Get grandparent.
+        auto grandparent_ptr = parent_ptr_->parent_ptr_;
+
+        // Get uncle.
+        auto uncle_ptr = grandparent_ptr->left_child_ptr_ == parent_ptr_ ? grandparent_ptr->right_child_ptr_ : grandparent_ptr->left_child_ptr_;
+
+        // Red uncle?
+        if (uncle_ptr && uncle_ptr->is_red_)
+        {
+            // Push "red" violation up the tree.
+            parent_ptr_->is_red_ = false;
+            uncle_ptr->is_red_ = false;
+            grandparent_ptr->is_red_ = true;
+
+            // Fixup at grandparent.
+            grandparent_ptr->fixup();
+        }
+
+        // No uncle or uncle is black.
+        else
+        {
+            // Rotate into place.
+            restructure();
+        }
+
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Resolves a "red" violation at this node whose uncle is black (or
+ *          missing) with one or two rotations; the grandparent must be black.
+ *          No violation is pushed further up the tree.
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::restructure()
+{
+    // Get grandparent.
+    auto grandparent_ptr = parent_ptr_->parent_ptr_;
+
+    // Left child?
+    auto is_left_child = parent_ptr_->left_child_ptr_.get() == this;
+
+    // Outer child (left child of left child or right child of right child)?
+    if (
+        (is_left_child && grandparent_ptr->left_child_ptr_ == parent_ptr_) ||
+        (!is_left_child && grandparent_ptr->right_child_ptr_ == parent_ptr_)
+    )
+    {
+        // Color parent black and grandparent red.
+        parent_ptr_->is_red_ = false;
+        grandparent_ptr->is_red_ = true;
+
+        // Rotate inward.
+        is_left_child ? parent_ptr_->rotate_right() : parent_ptr_->rotate_left();
+    }
+
+    // Inner child.
+    else
+    {
+        // Rotate outward about this node.
+        is_left_child ? rotate_right() : rotate_left();
+
+        // Fix as if case #2.
+        is_red_ = false;
+        parent_ptr_->is_red_ = true;
+
+        // Rotate inward about this node.
+        parent_ptr_->left_child_ptr_.get() == this ? rotate_right() : rotate_left();
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Balances tree after a black node was removed at this position
+ *          (this node carries an extra "black").
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::remove_fixup()
+{
+    // Node carrying the extra black.
+    auto node_ptr = this->shared_from_this();
+
+    // Push extra black up until it can be absorbed.
+    while (node_ptr->parent_ptr_ && !node_ptr->is_red_)
+    {
+        // Get parent.
+        auto parent_ptr = node_ptr->parent_ptr_;
+
+        // Left child?
+        auto is_left_child = parent_ptr->left_child_ptr_ == node_ptr;
+
+        // Get sibling.
+        auto sibling_ptr = is_left_child ? parent_ptr->right_child_ptr_ : parent_ptr->left_child_ptr_;
+
+        // Red sibling?
+        if (sibling_ptr->is_red_)
+        {
+            // Color sibling black and parent red.
+            sibling_ptr->is_red_ = false;
+            parent_ptr->is_red_ = true;
+
+            // Rotate sibling up.
+            is_left_child ? sibling_ptr->rotate_left() : sibling_ptr->rotate_right();
+
+            // Get new (black) sibling.
+            sibling_ptr = is_left_child ? parent_ptr->right_child_ptr_ : parent_ptr->left_child_ptr_;
+        }
+
+        // Get nephews.
+        auto outer_ptr = is_left_child ? sibling_ptr->right_child_ptr_ : sibling_ptr->left_child_ptr_;
+        auto inner_ptr = is_left_child ? sibling_ptr->left_child_ptr_ : sibling_ptr->right_child_ptr_;
+
+        // Both nephews black?
+        if (!outer_ptr->is_red_ && !inner_ptr->is_red_)
+        {
+            // Push extra black up the tree.
+            sibling_ptr->is_red_ = true;
+            node_ptr = parent_ptr;
+
+            // Continue at parent.
+            continue;
+        }
+
+        // Only inner nephew red?
+        if (!outer_ptr->is_red_)
+        {
+            // Color inner nephew black and sibling red.
+            inner_ptr->is_red_ = false;
+            sibling_ptr->is_red_ = true;
+
+            // Rotate inner nephew up (making it the outer case).
+            is_left_child ? inner_ptr->rotate_right() : inner_ptr->rotate_left();
+
+            // Update.
+            outer_ptr = sibling_ptr;
+            sibling_ptr = inner_ptr;
+        }
+
+        // Sibling takes parent color, parent and outer nephew become black.
+        sibling_ptr->is_red_ = parent_ptr->is_red_;
+        parent_ptr->is_red_ = false;
+        outer_ptr->is_red_ = false;
+
+        // Rotate sibling up (absorbs the extra black).
+        is_left_child ? sibling_ptr->rotate_left() : sibling_ptr->rotate_right();
+
+        // Done.
+        return;
+    }
+
+    // Absorb extra black.
+    node_ptr->is_red_ = false;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Rotate left about this node.
+ *
+ */
+template<typename T, typename A>
+void RedBlackNode<T, A>::rotate_left()
+{
+    // Save grandparent.
+    auto grandparent_ptr = parent_ptr_->parent_ptr_;
+
     // Is parent left child?
     auto is_parent_left_child = grandparent_ptr && grandparent_ptr->left_child_ptr_ == parent_ptr_;
 
@@ -502,6 +1711,10 @@ void RedBlackNode<T>::rotate_left()
     parent_ptr_ = grandparent_ptr;
     left_child_ptr_->parent_ptr_ = this->shared_from_this();
 
+    // Update summaries (new child first).
+    left_child_ptr_->refresh_summary();
+    refresh_summary();
+
     // New parent?
     if (parent_ptr_)
     {
@@ -516,8 +1729,8 @@ void RedBlackNode<T>::rotate_left()
  * @details Rotate right about this node.
  *
  */
-template<typename T>
-void RedBlackNode<T>::rotate_right()
+template<typename T, typename A>
+void RedBlackNode<T, A>::rotate_right()
 {
     // Save grandparent.
     auto grandparent_ptr = parent_ptr_->parent_ptr_;
@@ -534,6 +1747,10 @@ void RedBlackNode<T>::rotate_right()
     parent_ptr_ = grandparent_ptr;
     right_child_ptr_->parent_ptr_ = this->shared_from_this();
 
+    // Update summaries (new child first).
+    right_child_ptr_->refresh_summary();
+    refresh_summary();
+
     // New parent?
     if (parent_ptr_)
     {
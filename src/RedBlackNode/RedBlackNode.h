@@ -14,50 +14,96 @@
 //
 #ifndef RED_BLACK_NODE_H_
 #define RED_BLACK_NODE_H_
+#define RED_BLACK_BATCH_MIN_PARALLEL 4096
 //
 //  Header Files  //////////////////////////////////////////////////////////////
 //
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+#include <cstddef>
+#include "RedBlackAugment.h"
+#include "RedBlackKey.h"
+//
+//  Forward Declarations  //////////////////////////////////////////////////////
+//
+template<class T, class A>
+class RelaxedRedBlackTree;
 //
 //  Class Definition  //////////////////////////////////////////////////////////
 //
-template<class T>
-class RedBlackNode : public std::enable_shared_from_this<RedBlackNode <T> >
+template<class T, class A = NoAugment< T > >
+class RedBlackNode : public std::enable_shared_from_this<RedBlackNode <T, A> >
 {
 // Public members.
 public:
-    RedBlackNode(std::shared_ptr< RedBlackNode< T > > parent_ptr, bool is_red = false); /**< Default constructor */
-    RedBlackNode(const RedBlackNode<T>&); /**< Copy constructor */
+    typedef typename A::summary_type summary_type; /**< Type of the cached sub-tree summary */
+    typedef typename RedBlackKey< T >::cache_type key_cache_type; /**< Type of the per-node key cache */
+
+    RedBlackNode(std::shared_ptr< RedBlackNode< T, A > > parent_ptr, bool is_red = false); /**< Default constructor */
+    RedBlackNode(const RedBlackNode<T, A>&); /**< Copy constructor */
     ~RedBlackNode(); /**< Destructor */
 
     bool empty() const; /**< Returns boolean indicating whether the node is empty or not */
     bool is_root() const; /** Returns boolean value whether or not the node is the root */
-    std::shared_ptr< RedBlackNode< T > > parent() const; /**< Getter method for raw pointer to parent */
+    bool is_red() const; /**< Returns boolean indicating whether the node is red */
+    std::shared_ptr< RedBlackNode< T, A > > parent() const; /**< Getter method for raw pointer to parent */
+    std::shared_ptr< RedBlackNode< T, A > > root(); /**< Returns smart pointer to the root of the tree containing this node */
+    std::shared_ptr< RedBlackNode< T, A > > left_child() const; /**< Getter method for smart pointer to left child */
+    std::shared_ptr< RedBlackNode< T, A > > right_child() const; /**< Getter method for smart pointer to right child */
     unsigned int height() const; /**< Returns height of tree from which this node is the root */
     unsigned int total_nodes() const; /**< Returns the total number of nodes in the tree in which this node is the root */
     T value() const; /**< Returns value of node */
+    summary_type summary() const; /**< Returns the cached summary of the tree in which this node is the root */
+    summary_type aggregate(const T&, const T&) const; /**< Returns the summary of all values in the inclusive range */
     void clear(); /**< Clears node and all sub-trees. */
     bool contains(T) const; /**< Check if the value exists in the tree where this node is the root */
+    std::shared_ptr< T > floor(const T&) const; /**< Returns smart pointer to the greatest value not greater than the key (nullptr if none) */
     void each_preorder(std::function< void(std::shared_ptr<T>) >); /**< Executes provided function on each item in pre-order. */
     void each_inorder(std::function< void(std::shared_ptr<T>) >); /**< Executes provided function on each item in-order. */
     void each_postorder(std::function< void(std::shared_ptr<T>) >); /**< Executes provided function on each item in post-order. */
     bool add(const T&); /**< Adds item to correct place in tree (where this node is the root) and returns boolean value indicating success */
     bool remove(const T&); /**< Removes value from tree and returns boolean value indicating success */
+    void assign_sorted(const std::vector< T >&); /**< Replaces the tree (where this node is the root) with a balanced tree of the sorted values */
+    template<class I>
+    std::size_t insert_batch(I, I, unsigned int = 0); /**< Adds each distinct value of the range (where this node is the root) using worker threads and returns the number added */
 
 // Private members.
 private:
-    std::shared_ptr< RedBlackNode< T > > parent_ptr_; /**< Smart pointer to parent. */
+    std::shared_ptr< RedBlackNode< T, A > > parent_ptr_; /**< Smart pointer to parent. */
     std::shared_ptr< T > value_ptr_; /** Smart pointer to value of root node */
     bool is_red_; /**< Boolean value indicating whether the node is red. */
-    std::shared_ptr< RedBlackNode< T > > left_child_ptr_; /**< Smart pointer to the left child */
-    std::shared_ptr< RedBlackNode< T > > right_child_ptr_; /**< Smart pointer to the right child */
+    key_cache_type key_cache_; /**< Copy of part of the value (comparisons only), consulted before dereferencing it */
+    std::shared_ptr< RedBlackNode< T, A > > left_child_ptr_; /**< Smart pointer to the left child */
+    std::shared_ptr< RedBlackNode< T, A > > right_child_ptr_; /**< Smart pointer to the right child */
+    summary_type summary_; /**< Cached summary of the tree in which this node is the root */
 
-    std::shared_ptr< RedBlackNode< T > > fetch_descendant(T); /**< Search for child node with given value and return pointer to node */
+    bool add_cached(const T&, const key_cache_type&); /**< Adds item using its precomputed key cache */
+    std::shared_ptr< RedBlackNode< T, A > > add_unbalanced(const T&); /**< Adds item as a red leaf without re-balancing and returns its node */
+    template<class Q>
+    void fixup_step(Q&); /**< Performs one constant-time re-balancing step at this node and queues the nodes to step next */
+    std::shared_ptr< RedBlackNode< T, A > > fetch_descendant(const T&, const key_cache_type&) const; /**< Search for child node with given value and return pointer to node */
+    std::shared_ptr< T > floor_cached(const T&, const key_cache_type&) const; /**< Floor search using a precomputed key cache */
+    summary_type aggregate_from(const T&) const; /**< Returns the summary of all values not less than the bound */
+    summary_type aggregate_to(const T&) const; /**< Returns the summary of all values not greater than the bound */
+    void build_sorted(const std::vector< T >&, size_t, size_t, unsigned int, unsigned int, unsigned int); /**< Fills this empty node with the middle value of the slice and recurses (on new threads above the given depth) */
+    void collect_pieces(unsigned int, std::vector< std::shared_ptr< RedBlackNode< T, A > > >&, std::vector< std::shared_ptr< RedBlackNode< T, A > > >&); /**< Splits the top levels into disjoint sub-trees and the pivot nodes between them */
+    unsigned int black_height() const; /**< Returns the number of black nodes on the leftmost path */
+    static std::shared_ptr< RedBlackNode< T, A > > join(std::shared_ptr< RedBlackNode< T, A > >, std::shared_ptr< RedBlackNode< T, A > >, std::shared_ptr< RedBlackNode< T, A > >); /**< Joins two detached trees through a pivot node ordered between them and returns the new root */
+    static void sort_unique(std::vector< T >&, unsigned int); /**< Sorts and dedupes the values using worker threads */
+    static void run_parallel(std::size_t, std::function< void(std::size_t) >); /**< Runs the task for every index on its own thread */
+    void refresh_summary(); /**< Recomputes the cached summary from the children */
+    void propagate_summary(); /**< Recomputes the cached summaries from this node up to the root */
     void fixup(); /**< Re-balances the tree initiated from this node */
+    void restructure(); /**< Rotates a red node with a red parent and black uncle into place */
+    void remove_fixup(); /**< Re-balances the tree after a black node was removed at this node */
     void rotate_left(); /**< Rotates left with this node as the pivot */
     void rotate_right(); /**< Rotates right with this node as the pivot */
+
+    friend class RelaxedRedBlackTree< T, A >; /**< Drives add_unbalanced() and fixup_step() (they leave the tree unbalanced) */
 };
 //
 //  Implementation Files  //////////////////////////////////////////////////////
@@ -0,0 +1,391 @@
+/**
+ *
+ * @file RelaxedRedBlackTree.cpp
+ *
+ * @brief Relaxed-balance red-black tree class implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the RelaxedRedBlackTree class. Every public operation
+ *          holds the tree lock, so the maintenance thread only runs between
+ *          operations and in short slices.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef RELAXED_RED_BLACK_TREE_CPP_
+#define RELAXED_RED_BLACK_TREE_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <chrono>
+#include "RelaxedRedBlackTree.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Initializes an empty tree and starts the maintenance thread (if
+ *          enabled)
+ *
+ * @param[in] step_budget
+ *            Fix-up steps performed after each add (0 defers repairs until
+ *            RELAXED_MAX_PENDING violations are queued).
+ *
+ * @param[in] maintenance_us
+ *            Microseconds between background passes (0 disables them).
+ *
+ */
+template<typename T, typename A>
+RelaxedRedBlackTree<T, A>::RelaxedRedBlackTree(unsigned int step_budget, unsigned int maintenance_us)
+    : root_ptr_(std::make_shared< RedBlackNode< T, A > >(nullptr, false)),
+      pending_(),
+      step_budget_(step_budget),
+      maintenance_us_(maintenance_us),
+      is_stopping_(false)
+{
+    // Start maintainer.
+    if (maintenance_us_)
+    {
+        // Spawn.
+        maintainer_ = std::thread(&RelaxedRedBlackTree<T, A>::run_maintainer, this);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Stops the maintenance thread and frees the tree
+ *
+ */
+template<typename T, typename A>
+RelaxedRedBlackTree<T, A>::~RelaxedRedBlackTree()
+{
+    // Stop maintainer.
+    {
+        std::lock_guard< std::mutex > lock(mutex_);
+        is_stopping_ = true;
+    }
+    maintenance_cv_.notify_all();
+    if (maintainer_.joinable())
+    {
+        // Wait.
+        maintainer_.join();
+    }
+
+    // Free nodes (their parent links would keep them alive).
+    pending_.clear();
+    root_ptr_->clear();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns a boolean value indicating if the tree is empty
+ *
+ * @return Boolean value indicating if the tree is empty
+ *
+ */
+template<typename T, typename A>
+bool RelaxedRedBlackTree<T, A>::empty() const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Forward.
+    return root_ptr_->empty();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Searches the tree for the value; search order holds whatever the
+ *          balance
+ *
+ * @param[in] key
+ *            Value used for comparison in search.
+ *
+ * @return Boolean value that represents the results of the search.
+ *
+ */
+template<typename T, typename A>
+bool RelaxedRedBlackTree<T, A>::contains(T key) const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Forward.
+    return root_ptr_->contains(key);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the number of queued nodes; some may already be resolved
+ *
+ * @return Number of queued nodes (0 when the tree is fully balanced)
+ *
+ */
+template<typename T, typename A>
+std::size_t RelaxedRedBlackTree<T, A>::pending() const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Queue size.
+    return pending_.size();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the height of the tree
+ *
+ * @return Height of the tree
+ *
+ */
+template<typename T, typename A>
+unsigned int RelaxedRedBlackTree<T, A>::height() const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Forward.
+    return root_ptr_->height();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the root of the tree. Queued violations are still present
+ *          until rebalance() runs.
+ *
+ * @return Smart pointer to the root
+ *
+ */
+template<typename T, typename A>
+std::shared_ptr< RedBlackNode< T, A > > RelaxedRedBlackTree<T, A>::root() const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Return root.
+    return root_ptr_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the summary of all values in the inclusive range; summaries
+ *          are exact whatever the balance
+ *
+ * @param[in] low
+ *            Lower bound.
+ *
+ * @param[in] high
+ *            Upper bound.
+ *
+ * @return Summary of the values in [low, high]
+ *
+ */
+template<typename T, typename A>
+typename A::summary_type RelaxedRedBlackTree<T, A>::aggregate(const T& low, const T& high) const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Forward.
+    return root_ptr_->aggregate(low, high);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Iterates over the tree in-order and executes the iteratee on each
+ *          item (with the tree locked)
+ *
+ * @param[in] iteratee
+ *            Function to execute with each item.
+ *
+ */
+template<typename T, typename A>
+void RelaxedRedBlackTree<T, A>::each_inorder(std::function< void(std::shared_ptr< T >) > iteratee)
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Forward.
+    root_ptr_->each_inorder(iteratee);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Inserts the item as a red leaf, queues it and performs the step
+ *          budget of fix-up steps. The oldest violations are repaired first;
+ *          they sit nearest the root, where a burst of sorted keys is
+ *          resolved by a single rotation. A budget below 2 falls behind a
+ *          sorted burst, so past RELAXED_MAX_PENDING queued nodes the queue
+ *          is worked back down to that bound, which caps the height.
+ *
+ * @param[in] key
+ *            Value to add.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+template<typename T, typename A>
+bool RelaxedRedBlackTree<T, A>::add(const T& key)
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Insert and queue.
+    pending_.push_back(root_ptr_->add_unbalanced(key));
+
+    // Bounded repair.
+    step(step_budget_);
+
+    // Too many violations?
+    while (pending_.size() > RELAXED_MAX_PENDING)
+    {
+        // Repair down to the bound.
+        step(pending_.size() - RELAXED_MAX_PENDING);
+    }
+
+    // Return success.
+    return true;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Repairs every queued violation, then removes the value. Removal
+ *          re-balances with the strict fix-up, which needs a valid tree.
+ *
+ * @param[in] key
+ *            Value to remove.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+template<typename T, typename A>
+bool RelaxedRedBlackTree<T, A>::remove(const T& key)
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Drain queue.
+    while (step(RELAXED_MAINTENANCE_SLICE)) {}
+
+    // Remove and update root.
+    auto is_removed = root_ptr_->remove(key);
+    root_ptr_ = root_ptr_->root();
+
+    // Return result.
+    return is_removed;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Repairs every queued violation; afterwards the tree is a valid
+ *          red-black tree with height at most 2 log2(n + 1)
+ *
+ */
+template<typename T, typename A>
+void RelaxedRedBlackTree<T, A>::rebalance()
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Drain queue.
+    while (step(RELAXED_MAINTENANCE_SLICE)) {}
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Steps queued nodes, oldest first (with the tree locked), then re-finds
+ *          the root in case a rotation moved it
+ *
+ * @param[in] budget
+ *            Maximum number of steps.
+ *
+ * @return Number of steps performed
+ *
+ */
+template<typename T, typename A>
+std::size_t RelaxedRedBlackTree<T, A>::step(std::size_t budget)
+{
+    // Step.
+    std::size_t steps = 0;
+    while (steps < budget && !pending_.empty())
+    {
+        // Pop and repair.
+        auto node_ptr = pending_.front();
+        pending_.pop_front();
+        node_ptr->fixup_step(pending_);
+        ++steps;
+    }
+
+    // Root moved?
+    if (steps)
+    {
+        // Update.
+        root_ptr_ = root_ptr_->root();
+    }
+
+    // Return count.
+    return steps;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Every period, repairs queued violations a slice at a time,
+ *          releasing the lock between slices so writers are not stalled
+ *
+ */
+template<typename T, typename A>
+void RelaxedRedBlackTree<T, A>::run_maintainer()
+{
+    // Lock.
+    std::unique_lock< std::mutex > lock(mutex_);
+
+    // Run until stopped.
+    while (!is_stopping_)
+    {
+        // One slice.
+        if (step(RELAXED_MAINTENANCE_SLICE))
+        {
+            // Let others in, then continue.
+            lock.unlock();
+            std::this_thread::yield();
+            lock.lock();
+            continue;
+        }
+
+        // Idle until next period.
+        maintenance_cv_.wait_for(lock, std::chrono::microseconds(maintenance_us_), [this] { return is_stopping_; });
+    }
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // RELAXED_RED_BLACK_TREE_CPP_
+//
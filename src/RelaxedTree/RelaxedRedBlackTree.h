@@ -0,0 +1,85 @@
+/**
+ *
+ * @file RelaxedRedBlackTree.h
+ *
+ * @brief Relaxed-balance red-black tree class definition.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the RelaxedRedBlackTree class, a write-burst mode where
+ *          add() inserts a red leaf and only queues the "red" violation it
+ *          may cause. Violations are repaired in constant-time steps: a
+ *          bounded number after each add(), optionally by a background
+ *          maintenance thread, and all of them by rebalance(), which restores
+ *          the red-black height bound. Black heights stay equal throughout,
+ *          so only red nodes with red parents are ever out of place, and each
+ *          of them is queued. add() never leaves more than RELAXED_MAX_PENDING
+ *          queued, so the height stays at most 2 log2(n + 1) + 1 +
+ *          RELAXED_MAX_PENDING whatever the step budget.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef RELAXED_RED_BLACK_TREE_H_
+#define RELAXED_RED_BLACK_TREE_H_
+#define RELAXED_STEP_BUDGET 4
+#define RELAXED_MAINTENANCE_SLICE 256
+#define RELAXED_MAX_PENDING 64
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <memory>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstddef>
+#include "../RedBlackNode/RedBlackNode.h"
+//
+//  Class Definition  //////////////////////////////////////////////////////////
+//
+template<class T, class A = NoAugment< T > >
+class RelaxedRedBlackTree
+{
+// Public members.
+public:
+    RelaxedRedBlackTree(unsigned int step_budget = RELAXED_STEP_BUDGET, unsigned int maintenance_us = 0); /**< Constructor (budget of steps per add; background pass period, 0 disables) */
+    RelaxedRedBlackTree(const RelaxedRedBlackTree<T, A>&) = delete; /**< Not copyable (owns a thread) */
+    ~RelaxedRedBlackTree(); /**< Destructor (stops the maintenance thread and frees the tree) */
+
+    bool empty() const; /**< Returns boolean indicating whether the tree is empty */
+    bool contains(T) const; /**< Check if the value exists in the tree */
+    std::size_t pending() const; /**< Returns the number of queued (possible) violations */
+    unsigned int height() const; /**< Returns height of the tree */
+    std::shared_ptr< RedBlackNode< T, A > > root() const; /**< Returns smart pointer to the root (a valid red-black tree after rebalance()) */
+    typename A::summary_type aggregate(const T&, const T&) const; /**< Returns the summary of all values in the inclusive range */
+    void each_inorder(std::function< void(std::shared_ptr<T>) >); /**< Executes provided function on each item in-order. */
+    bool add(const T&); /**< Adds item, repairs the step budget (more past RELAXED_MAX_PENDING) and returns boolean value indicating success */
+    bool remove(const T&); /**< Rebalances, removes value and returns boolean value indicating success */
+    void rebalance(); /**< Repairs every queued violation (restores the height bound) */
+
+// Private members.
+private:
+    std::shared_ptr< RedBlackNode< T, A > > root_ptr_; /**< Smart pointer to the root of the tree */
+    std::deque< std::shared_ptr< RedBlackNode< T, A > > > pending_; /**< Queue of nodes that may be in violation (oldest first) */
+    unsigned int step_budget_; /**< Fix-up steps after each add */
+    unsigned int maintenance_us_; /**< Period of the background pass (0 disables) */
+    mutable std::mutex mutex_; /**< Guards the tree and the queue */
+    std::condition_variable maintenance_cv_; /**< Wakes the maintenance thread to stop */
+    bool is_stopping_; /**< Boolean value telling the maintenance thread to exit */
+    std::thread maintainer_; /**< Background maintenance thread */
+
+    std::size_t step(std::size_t); /**< Performs up to the given number of fix-up steps and returns the number performed */
+    void run_maintainer(); /**< Maintenance thread body */
+};
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "RelaxedRedBlackTree.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // RELAXED_RED_BLACK_TREE_H_
+//
@@ -0,0 +1,695 @@
+/**
+ *
+ * @file WriteAheadLog.cpp
+ *
+ * @brief Write-ahead log class implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the WriteAheadLog class. A record is the operation
+ *          byte, the sequence number, the raw key bytes and an FNV-1a checksum
+ *          of the preceding bytes, all in host byte order (the log is local).
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef WRITE_AHEAD_LOG_CPP_
+#define WRITE_AHEAD_LOG_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include "WriteAheadLog.h"
+//
+//  Static Member Definitions  /////////////////////////////////////////////////
+//
+template<typename T>
+const std::size_t WriteAheadLog<T>::RECORD_SIZE;
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Opens the log for appending and starts the flusher thread (only
+ *          when a time bound is set)
+ *
+ * @param[in] path
+ *            Path of the log file.
+ *
+ * @param[in] last_lsn
+ *            Sequence number already used by recovered records.
+ *
+ * @param[in] sync_every_ops
+ *            Sync once this many records are pending (0 disables).
+ *
+ * @param[in] sync_every_us
+ *            Sync once the oldest pending record is this many microseconds
+ *            old (0 disables).
+ *
+ */
+template<typename T>
+WriteAheadLog<T>::WriteAheadLog(
+    const std::string& path,
+    std::uint64_t last_lsn,
+    unsigned int sync_every_ops,
+    unsigned int sync_every_us
+)
+    : path_(path),
+      fd_(-1),
+      last_lsn_(last_lsn),
+      file_size_(0),
+      buffer_(),
+      rotated_fd_(-1),
+      rotated_size_(0),
+      rotated_buffer_(),
+      pending_ops_(0),
+      oldest_pending_(),
+      sync_every_ops_(sync_every_ops),
+      sync_every_us_(sync_every_us),
+      error_(0),
+      is_stopping_(false)
+{
+    // Open file.
+    open_log();
+
+    // Time-based sync?
+    if (sync_every_us_)
+    {
+        // Start flusher.
+        flusher_ = std::thread(&WriteAheadLog<T>::run_flusher, this);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Stops the flusher thread, syncs pending records and closes the log
+ *
+ */
+template<typename T>
+WriteAheadLog<T>::~WriteAheadLog()
+{
+    // Stop flusher.
+    {
+        std::lock_guard< std::mutex > lock(mutex_);
+        is_stopping_ = true;
+    }
+    flusher_cv_.notify_all();
+    if (flusher_.joinable())
+    {
+        // Wait.
+        flusher_.join();
+    }
+
+    // Sync and close (never throw from a destructor).
+    try
+    {
+        sync();
+    }
+    catch (const std::system_error&) {}
+    ::close(fd_);
+
+    // Renamed log left by a failed sync?
+    if (rotated_fd_ >= 0)
+    {
+        // Close.
+        ::close(rotated_fd_);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Encodes a record into the pending buffer. No I/O happens here, so
+ *          callers may append under their own locks and call commit() once
+ *          they have released them. Records are durable only after the sync
+ *          that covers them.
+ *
+ * @param[in] operation
+ *            Logged operation.
+ *
+ * @param[in] key
+ *            Key the operation applies to.
+ *
+ * @return Sequence number of the record
+ *
+ */
+template<typename T>
+std::uint64_t WriteAheadLog<T>::append(Operation operation, const T& key)
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Failed log?
+    check_healthy();
+
+    // Next sequence number.
+    auto lsn = ++last_lsn_;
+
+    // Encode.
+    auto offset = buffer_.size();
+    buffer_.resize(offset + RECORD_SIZE);
+    auto cursor_ptr = buffer_.data() + offset;
+    std::uint8_t op_byte = operation;
+    std::memcpy(cursor_ptr, &op_byte, sizeof(op_byte));
+    std::memcpy(cursor_ptr + sizeof(op_byte), &lsn, sizeof(lsn));
+    std::memcpy(cursor_ptr + sizeof(op_byte) + sizeof(lsn), &key, sizeof(T));
+    auto sum = checksum(cursor_ptr, RECORD_SIZE - sizeof(std::uint32_t));
+    std::memcpy(cursor_ptr + RECORD_SIZE - sizeof(sum), &sum, sizeof(sum));
+
+    // First pending record?
+    if (pending_ops_++ == 0)
+    {
+        // Start the clock and wake the flusher.
+        oldest_pending_ = std::chrono::steady_clock::now();
+        flusher_cv_.notify_one();
+    }
+
+    // Return sequence number.
+    return lsn;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Syncs the pending records once the operation bound is reached (the
+ *          group commit). A failed sync fails the log.
+ *
+ */
+template<typename T>
+void WriteAheadLog<T>::commit()
+{
+    // Operation bound reached?
+    {
+        std::lock_guard< std::mutex > lock(mutex_);
+        if (!sync_every_ops_ || pending_ops_ < sync_every_ops_)
+        {
+            // Done.
+            return;
+        }
+    }
+
+    // Group commit.
+    sync();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Writes and fsyncs every pending record
+ *
+ */
+template<typename T>
+void WriteAheadLog<T>::sync()
+{
+    // One writer at a time.
+    std::lock_guard< std::mutex > sync_lock(sync_mutex_);
+
+    // Write.
+    write_pending();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the sequence number of the last appended record
+ *
+ * @return Last sequence number
+ *
+ */
+template<typename T>
+std::uint64_t WriteAheadLog<T>::last_lsn() const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Return.
+    return last_lsn_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the size of the current log (written and pending) in bytes
+ *
+ * @return Log size in bytes
+ *
+ */
+template<typename T>
+std::uint64_t WriteAheadLog<T>::size() const
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // Return.
+    return file_size_ + buffer_.size();
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Renames the log and starts an empty log at the original path. Used
+ *          by compaction: once a checkpoint covering the returned sequence
+ *          number is durable, the renamed log can be deleted. Only the rename
+ *          and open happen here, so callers may rotate under their own locks;
+ *          the renamed log keeps its descriptor, and its pending records (and
+ *          any write in flight) are completed by the next sync, before the
+ *          new log's records.
+ *
+ * @param[in] rotated_path
+ *            New path of the current log.
+ *
+ * @return Sequence number of the last record in the renamed log
+ *
+ */
+template<typename T>
+std::uint64_t WriteAheadLog<T>::rotate(const std::string& rotated_path)
+{
+    // Lock.
+    std::lock_guard< std::mutex > lock(mutex_);
+    check_healthy();
+
+    // Previous renamed log not synced yet?
+    if (rotated_fd_ >= 0)
+    {
+        // Fail (its records would be mixed with this log's).
+        throw std::logic_error("rotate " + path_ + " before syncing the previous rotation");
+    }
+
+    // Rename.
+    if (std::rename(path_.c_str(), rotated_path.c_str()) != 0)
+    {
+        // Fail.
+        throw std::system_error(errno, std::generic_category(), "rename " + path_);
+    }
+
+    // Move the pending records to the renamed log.
+    rotated_fd_ = fd_;
+    rotated_size_ = file_size_;
+    rotated_buffer_.swap(buffer_);
+
+    // Start new log.
+    open_log();
+
+    // Return last sequence number (every appended record is in the renamed log).
+    return last_lsn_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Reads the log and applies every record with a sequence number
+ *          greater than the given one (and than any record before it). Stops
+ *          at the first short or corrupt record (a write torn by a crash).
+ *
+ * @param[in] path
+ *            Path of the log file (a missing file holds no records).
+ *
+ * @param[in] after_lsn
+ *            Records up to and including this sequence number are skipped.
+ *
+ * @param[in] iteratee
+ *            Function to execute with each applied record.
+ *
+ * @return Largest sequence number read (after_lsn if none)
+ *
+ */
+template<typename T>
+std::uint64_t WriteAheadLog<T>::replay(
+    const std::string& path,
+    std::uint64_t after_lsn,
+    std::function< void(Operation, const T&) > iteratee
+)
+{
+    // Open.
+    auto file_ptr = std::fopen(path.c_str(), "rb");
+    auto last_lsn = after_lsn;
+
+    // Missing?
+    if (!file_ptr)
+    {
+        // Nothing to replay.
+        return last_lsn;
+    }
+
+    // Record buffer.
+    char record[RECORD_SIZE];
+
+    // Read records.
+    while (std::fread(record, 1, RECORD_SIZE, file_ptr) == RECORD_SIZE)
+    {
+        // Decode.
+        std::uint8_t op_byte;
+        std::uint64_t lsn;
+        T key;
+        std::uint32_t sum;
+        std::memcpy(&op_byte, record, sizeof(op_byte));
+        std::memcpy(&lsn, record + sizeof(op_byte), sizeof(lsn));
+        std::memcpy(&key, record + sizeof(op_byte) + sizeof(lsn), sizeof(T));
+        std::memcpy(&sum, record + RECORD_SIZE - sizeof(sum), sizeof(sum));
+
+        // Torn or corrupt?
+        if (sum != checksum(record, RECORD_SIZE - sizeof(sum)) || (op_byte != ADD && op_byte != REMOVE))
+        {
+            // Stop.
+            break;
+        }
+
+        // Not yet covered by a checkpoint or an earlier copy of the record?
+        if (lsn > last_lsn)
+        {
+            // Apply.
+            iteratee(static_cast< Operation >(op_byte), key);
+
+            // Track.
+            last_lsn = lsn;
+        }
+    }
+
+    // Close.
+    std::fclose(file_ptr);
+
+    // Return last sequence number.
+    return last_lsn;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Opens the log file for appending (creating it if needed) and
+ *          records its current size
+ *
+ */
+template<typename T>
+void WriteAheadLog<T>::open_log()
+{
+    // Open.
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+
+    // Failed?
+    if (fd_ < 0)
+    {
+        // Fail.
+        throw std::system_error(errno, std::generic_category(), "open " + path_);
+    }
+
+    // Record size.
+    auto end = ::lseek(fd_, 0, SEEK_END);
+    file_size_ = end < 0 ? 0 : end;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Takes the pending buffers and writes them, the renamed log's first
+ *          (its records are older), with one write call and one fsync per
+ *          file (the group commit). Appends only wait for the swap, not for
+ *          the disk. Expects the sync mutex (and not the mutex) to be held.
+ *
+ */
+template<typename T>
+void WriteAheadLog<T>::write_pending()
+{
+    // Take pending records.
+    int rotated_fd;
+    std::uint64_t rotated_size;
+    std::vector< char > rotated_records;
+    int fd;
+    std::uint64_t size;
+    std::vector< char > records;
+    {
+        std::lock_guard< std::mutex > lock(mutex_);
+        check_healthy();
+        rotated_fd = rotated_fd_;
+        rotated_size = rotated_size_;
+        rotated_records.swap(rotated_buffer_);
+        rotated_fd_ = -1;
+        fd = fd_;
+        size = file_size_;
+        records.swap(buffer_);
+        pending_ops_ = 0;
+    }
+
+    // Complete renamed log.
+    if (rotated_fd >= 0)
+    {
+        // Write and close (closed on failure too).
+        try
+        {
+            write_records(rotated_fd, rotated_size, rotated_records);
+        }
+        catch (const std::system_error&)
+        {
+            ::close(rotated_fd);
+            throw;
+        }
+        ::close(rotated_fd);
+    }
+
+    // Write current log.
+    write_records(fd, size, records);
+
+    // Record size (a rotation during the write moved the file aside).
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (fd == fd_)
+    {
+        // Still current.
+        file_size_ += records.size();
+    }
+    else
+    {
+        // Renamed.
+        rotated_size_ += records.size();
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Writes the records at the end of the file with one write call and
+ *          one fsync. Any failure fails the log, so a partial write is never
+ *          followed by records replay cannot reach. Expects the sync mutex
+ *          (and not the mutex) to be held.
+ *
+ * @param[in] fd
+ *            Descriptor of the file.
+ *
+ * @param[in] size
+ *            Bytes already written to the file.
+ *
+ * @param[in] records
+ *            Encoded records.
+ *
+ */
+template<typename T>
+void WriteAheadLog<T>::write_records(int fd, std::uint64_t size, const std::vector< char >& records)
+{
+    // Nothing to write?
+    if (records.empty())
+    {
+        // Done.
+        return;
+    }
+
+    // Write everything.
+    std::size_t written = 0;
+    while (written < records.size())
+    {
+        // Write.
+        auto result = ::write(fd, records.data() + written, records.size() - written);
+
+        // Failed?
+        if (result < 0)
+        {
+            // Retry on interrupt.
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            // Fail.
+            auto error = errno;
+            std::lock_guard< std::mutex > lock(mutex_);
+            fail_locked(fd, size, error, "write " + path_);
+        }
+
+        // Advance.
+        written += result;
+    }
+
+    // Flush to disk.
+    if (::fsync(fd) != 0)
+    {
+        // Fail.
+        auto error = errno;
+        std::lock_guard< std::mutex > lock(mutex_);
+        fail_locked(fd, size, error, "fsync " + path_);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Throws the error that failed the log, if any. Expects the mutex to
+ *          be held.
+ *
+ */
+template<typename T>
+void WriteAheadLog<T>::check_healthy() const
+{
+    // Failed?
+    if (error_)
+    {
+        // Fail.
+        throw std::system_error(error_, std::generic_category(), "failed log " + path_);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Truncates the file back to the synced records (dropping any part of
+ *          the records a write got out), drops the buffers (records appended
+ *          during the write) and fails the log.
+ *          After a failed fsync the kernel may have discarded the dirty pages,
+ *          so a retry could report records durable that are not; the log
+ *          stops instead. Expects both mutexes to be held.
+ *
+ * @param[in] fd
+ *            Descriptor of the failed file.
+ *
+ * @param[in] size
+ *            Bytes synced to the failed file.
+ *
+ * @param[in] error
+ *            Error number of the failure.
+ *
+ * @param[in] what
+ *            Failed call and path.
+ *
+ */
+template<typename T>
+void WriteAheadLog<T>::fail_locked(int fd, std::uint64_t size, int error, const std::string& what)
+{
+    // Cut the unsynced tail (retry on interrupt).
+    while (::ftruncate(fd, size) != 0 && errno == EINTR) {}
+
+    // Drop pending records.
+    buffer_.clear();
+    rotated_buffer_.clear();
+    pending_ops_ = 0;
+
+    // Fail.
+    error_ = error;
+    throw std::system_error(error, std::generic_category(), what);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Sleeps until records are pending, then syncs once the oldest one
+ *          reaches the time bound
+ *
+ */
+template<typename T>
+void WriteAheadLog<T>::run_flusher()
+{
+    // Lock.
+    std::unique_lock< std::mutex > lock(mutex_);
+
+    // Time bound.
+    auto bound = std::chrono::microseconds(sync_every_us_);
+
+    // Run until stopped.
+    while (!is_stopping_)
+    {
+        // Nothing pending?
+        if (!pending_ops_)
+        {
+            // Wait for an append.
+            flusher_cv_.wait(lock);
+            continue;
+        }
+
+        // Oldest record due?
+        auto deadline = oldest_pending_ + bound;
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            // Sync without blocking appends (errors fail the log; keep running).
+            lock.unlock();
+            try
+            {
+                sync();
+            }
+            catch (const std::system_error&) {}
+            lock.lock();
+            continue;
+        }
+
+        // Wait for the deadline.
+        flusher_cv_.wait_until(lock, deadline);
+    }
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Computes the 32-bit FNV-1a hash of the bytes. Passing a previous
+ *          result as the seed hashes discontiguous data as one sequence.
+ *
+ * @param[in] data_ptr
+ *            Bytes to hash.
+ *
+ * @param[in] length
+ *            Number of bytes.
+ *
+ * @param[in] seed
+ *            Starting hash (the FNV offset basis by default).
+ *
+ * @return Hash value
+ *
+ */
+template<typename T>
+std::uint32_t WriteAheadLog<T>::checksum(const char* data_ptr, std::size_t length, std::uint32_t seed)
+{
+    // Start from seed.
+    auto hash = seed;
+
+    // Mix bytes.
+    for (std::size_t i = 0; i < length; i++)
+    {
+        // Xor, then multiply by prime.
+        hash ^= (unsigned char) data_ptr[i];
+        hash *= 16777619u;
+    }
+
+    // Return hash.
+    return hash;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // WRITE_AHEAD_LOG_CPP_
+//
\ No newline at end of file
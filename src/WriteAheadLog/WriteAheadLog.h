@@ -0,0 +1,98 @@
+/**
+ *
+ * @file WriteAheadLog.h
+ *
+ * @brief Write-ahead log class definition.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the WriteAheadLog class, an append-only file of compact
+ *          binary add/remove records with group commit: appended records are
+ *          buffered and written with a single fsync once enough operations
+ *          are pending (commit) or the oldest pending record is old enough
+ *          (flusher thread). Appends never wait for the disk. A failed
+ *          sync fails the log: nothing more is written to it.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef WRITE_AHEAD_LOG_H_
+#define WRITE_AHEAD_LOG_H_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+//
+//  Class Definition  //////////////////////////////////////////////////////////
+//
+template<class T>
+class WriteAheadLog
+{
+    static_assert(std::is_trivially_copyable< T >::value, "Logged keys must be trivially copyable");
+
+// Public members.
+public:
+    enum Operation : std::uint8_t { ADD = 1, REMOVE = 2 }; /**< Logged operations */
+
+    WriteAheadLog(const std::string& path, std::uint64_t last_lsn, unsigned int sync_every_ops, unsigned int sync_every_us); /**< Default constructor */
+    WriteAheadLog(const WriteAheadLog<T>&) = delete; /**< Not copyable (owns a file and a thread) */
+    ~WriteAheadLog(); /**< Destructor (syncs pending records) */
+
+    std::uint64_t append(Operation, const T&); /**< Buffers a record (no I/O) and returns its sequence number */
+    void commit(); /**< Writes and fsyncs the pending records once the operation bound is reached */
+    void sync(); /**< Writes and fsyncs all pending records */
+    std::uint64_t last_lsn() const; /**< Returns the sequence number of the last appended record */
+    std::uint64_t size() const; /**< Returns the size of the current log file (including pending records) in bytes */
+    std::uint64_t rotate(const std::string&); /**< Renames the log and starts a new one (no fsync); returns the last sequence number in the renamed log */
+
+    static std::uint32_t checksum(const char*, std::size_t, std::uint32_t = 2166136261u); /**< FNV-1a hash of the bytes (chainable through the seed) */
+    static std::uint64_t replay(const std::string&, std::uint64_t, std::function< void(Operation, const T&) >); /**< Applies valid records after the sequence number and returns the last sequence number read */
+
+    static const std::size_t RECORD_SIZE = sizeof(std::uint8_t) + sizeof(std::uint64_t) + sizeof(T) + sizeof(std::uint32_t); /**< Encoded record size in bytes */
+
+// Private members.
+private:
+    std::string path_; /**< Path of the log file */
+    int fd_; /**< Descriptor of the log file */
+    std::uint64_t last_lsn_; /**< Sequence number of the last appended record */
+    std::uint64_t file_size_; /**< Bytes already written to the log file */
+    std::vector< char > buffer_; /**< Encoded records awaiting the next sync */
+    int rotated_fd_; /**< Descriptor of a renamed log with unwritten records (-1 if none) */
+    std::uint64_t rotated_size_; /**< Bytes already written to the renamed log */
+    std::vector< char > rotated_buffer_; /**< Encoded records awaiting the next sync, for the renamed log */
+    unsigned int pending_ops_; /**< Number of records in both buffers */
+    std::chrono::steady_clock::time_point oldest_pending_; /**< Append time of the first record in the buffer */
+    unsigned int sync_every_ops_; /**< Sync once this many records are pending (0 disables) */
+    unsigned int sync_every_us_; /**< Sync once the oldest pending record is this old (0 disables) */
+    int error_; /**< Error that failed the log (0 while healthy) */
+    bool is_stopping_; /**< Boolean value telling the flusher thread to exit */
+    mutable std::mutex mutex_; /**< Guards every member above */
+    std::mutex sync_mutex_; /**< Serializes writes to the log file (taken before the mutex) */
+    std::condition_variable flusher_cv_; /**< Wakes the flusher thread */
+    std::thread flusher_; /**< Thread enforcing the time-based sync bound */
+
+    void open_log(); /**< Opens (creating if needed) the log file for appending */
+    void write_pending(); /**< Takes the buffers, then writes and fsyncs them (sync mutex held) */
+    void write_records(int, std::uint64_t, const std::vector< char >&); /**< Writes and fsyncs records at the end of a file (sync mutex held) */
+    void check_healthy() const; /**< Throws if an earlier sync failed the log (mutex held) */
+    void fail_locked(int, std::uint64_t, int, const std::string&); /**< Truncates a file's unsynced tail, drops the buffers and fails the log (both mutexes held) */
+    void run_flusher(); /**< Flusher thread body */
+};
+//
+//  Implementation Files  //////////////////////////////////////////////////////
+//
+#include "WriteAheadLog.cpp"
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // WRITE_AHEAD_LOG_H_
+//
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+ *
+ * @file batch_benchmark.cpp
+ *
+ * @brief Throughput benchmark for batch-parallel insertion.
+ *
+ * @author Josh Wiley
+ *
+ * @details Inserts the same batches of random keys into a pre-filled tree
+ *          with the sequential add() loop of the driver and with
+ *          insert_batch() at increasing thread counts, and reports the
+ *          throughput and speedup of each.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef BATCH_BENCHMARK_CPP_
+#define BATCH_BENCHMARK_CPP_
+#define BENCHMARK_PREFILL 200000
+#define BENCHMARK_BATCH 1000000
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <thread>
+#include <functional>
+#include "../RedBlackNode/RedBlackNode.h"
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Runs the function and returns its wall-clock time
+ *
+ * @param[in] body
+ *            Function to time.
+ *
+ * @return Elapsed seconds
+ *
+ */
+double time_seconds(std::function< void() > body)
+{
+  // Time.
+  auto start = std::chrono::steady_clock::now();
+  body();
+  return std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Builds a tree holding the keys
+ *
+ * @param[in] keys
+ *            Keys to add.
+ *
+ * @return Smart pointer to the root
+ *
+ */
+std::shared_ptr< RedBlackNode< unsigned int > > prefilled(const std::vector< unsigned int >& keys)
+{
+  // Build.
+  auto root_ptr = std::make_shared< RedBlackNode< unsigned int > >(nullptr, false);
+  root_ptr->assign_sorted(keys);
+  return root_ptr;
+}
+//
+//  Main Function Implementation  //////////////////////////////////////////////
+//
+int main()
+{
+    // Prefill (sorted, distinct) and batch keys.
+    std::mt19937 generator(11);
+    std::vector< unsigned int > prefill(BENCHMARK_PREFILL);
+    std::vector< unsigned int > batch(BENCHMARK_BATCH);
+    for (std::size_t i = 0; i < prefill.size(); i++)
+    {
+        // Even spread.
+        prefill[i] = (unsigned int) (i * 4096);
+    }
+    for (auto& key : batch)
+    {
+        // Generate.
+        key = generator();
+    }
+
+    // Header.
+    std::cout << "\n\n" << BENCHMARK_BATCH << " keys into a tree of " << BENCHMARK_PREFILL << ":\n"
+              << "  " << std::left << std::setw(22) << "method" << std::right
+              << std::setw(14) << "keys/s" << std::setw(10) << "speedup" << '\n';
+
+    // Sequential add() loop.
+    auto root_ptr = prefilled(prefill);
+    auto sequential_seconds = time_seconds([&] {
+        for (const auto& key : batch)
+        {
+            // Add and update root.
+            root_ptr->add(key);
+            root_ptr = root_ptr->root();
+        }
+    });
+    std::cout << "  " << std::left << std::setw(22) << "add() loop" << std::right
+              << std::setw(14) << (long) (BENCHMARK_BATCH / sequential_seconds)
+              << std::setw(10) << std::setprecision(2) << std::fixed << 1.0 << '\n';
+
+    // Batch insert at increasing thread counts.
+    auto hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int threads = 1; threads <= hardware; threads *= 2)
+    {
+        // Free the previous tree, then time.
+        root_ptr->clear();
+        root_ptr = prefilled(prefill);
+        auto batch_seconds = time_seconds([&] {
+            root_ptr->insert_batch(batch.begin(), batch.end(), threads);
+        });
+        root_ptr = root_ptr->root();
+        std::cout << "  " << std::left << std::setw(22) << ("insert_batch x" + std::to_string(threads)) << std::right
+                  << std::setw(14) << (long) (BENCHMARK_BATCH / batch_seconds)
+                  << std::setw(10) << sequential_seconds / batch_seconds << '\n';
+    }
+
+    // Free the last tree.
+    root_ptr->clear();
+
+    // Padding and flush stream.
+    std::cout << '\n' << std::endl;
+
+    // Exit (success).
+    return 0;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // BATCH_BENCHMARK_CPP_
+//
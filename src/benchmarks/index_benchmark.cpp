@@ -0,0 +1,188 @@
+/**
+ *
+ * @file index_benchmark.cpp
+ *
+ * @brief Memory/throughput benchmark for the hash-indexed red-black tree.
+ *
+ * @author Josh Wiley
+ *
+ * @details Builds a plain tree, a hash-indexed tree and a frozen sorted array
+ *          from the same random keys, then times insertion and point probes
+ *          (half hits, half misses) and estimates the memory of each.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef INDEX_BENCHMARK_CPP_
+#define INDEX_BENCHMARK_CPP_
+#define BENCHMARK_SIZE 200000
+#define BENCHMARK_PROBES 1000000
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "../RedBlackNode/RedBlackNode.h"
+#include "../IndexedTree/IndexedRedBlackTree.h"
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Runs the function and returns its wall-clock time
+ *
+ * @param[in] body
+ *            Function to time.
+ *
+ * @return Elapsed seconds
+ *
+ */
+double time_seconds(std::function< void() > body)
+{
+  // Time.
+  auto start = std::chrono::steady_clock::now();
+  body();
+  return std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Prints one result row
+ *
+ * @param[in] name
+ *            Layout name.
+ *
+ * @param[in] insert_seconds
+ *            Time taken to build the layout.
+ *
+ * @param[in] probe_seconds
+ *            Time taken by the probes.
+ *
+ * @param[in] bytes
+ *            Estimated memory of the layout.
+ *
+ * @param[in] hits
+ *            Number of probes that found their key.
+ *
+ */
+void report(const char* name, double insert_seconds, double probe_seconds, std::size_t bytes, std::size_t hits)
+{
+  // Row.
+  std::cout << "  " << std::left << std::setw(20) << name << std::right
+            << std::setw(14) << (long) (BENCHMARK_SIZE / insert_seconds)
+            << std::setw(14) << (long) (BENCHMARK_PROBES / probe_seconds)
+            << std::setw(12) << std::setprecision(1) << std::fixed << bytes / (double) BENCHMARK_SIZE
+            << std::setw(10) << hits << '\n';
+}
+//
+//  Main Function Implementation  //////////////////////////////////////////////
+//
+int main()
+{
+    // Keys (even values) and probes (half stored, half odd misses).
+    std::mt19937 generator(7);
+    std::uniform_int_distribution< unsigned int > distribution(0, 1u << 30);
+    std::vector< unsigned int > keys(BENCHMARK_SIZE);
+    std::vector< unsigned int > probes(BENCHMARK_PROBES);
+    for (auto& key : keys)
+    {
+        // Generate.
+        key = distribution(generator) * 2;
+    }
+    for (std::size_t i = 0; i < probes.size(); i++)
+    {
+        // Generate.
+        probes[i] = i % 2 ? keys[generator() % keys.size()] : distribution(generator) * 2 + 1;
+    }
+
+    // Estimated tree bytes: every node and value is a make_shared block, and
+    // each stored value has two empty children below it or its descendants.
+    auto tree_bytes = (2 * BENCHMARK_SIZE + 1) * (sizeof(RedBlackNode< unsigned int >) + 16)
+                    + BENCHMARK_SIZE * (sizeof(unsigned int) + 16);
+
+    // Header.
+    std::cout << "\n\n" << BENCHMARK_SIZE << " keys, " << BENCHMARK_PROBES << " contains() probes:\n"
+              << "  " << std::left << std::setw(20) << "layout" << std::right
+              << std::setw(14) << "inserts/s" << std::setw(14) << "probes/s"
+              << std::setw(12) << "bytes/key" << std::setw(10) << "hits" << '\n';
+
+    // Plain tree.
+    {
+        auto root_ptr = std::make_shared< RedBlackNode< unsigned int > >(nullptr, false);
+        auto insert_seconds = time_seconds([&] {
+            for (const auto& key : keys)
+            {
+                // Add and update root.
+                root_ptr->add(key);
+                root_ptr = root_ptr->root();
+            }
+        });
+        std::size_t hits = 0;
+        auto probe_seconds = time_seconds([&] {
+            for (const auto& probe : probes)
+            {
+                // Probe.
+                hits += root_ptr->contains(probe);
+            }
+        });
+        report("plain tree", insert_seconds, probe_seconds, tree_bytes, hits);
+    }
+
+    // Indexed tree.
+    {
+        IndexedRedBlackTree< unsigned int > tree;
+        auto insert_seconds = time_seconds([&] {
+            for (const auto& key : keys)
+            {
+                // Add.
+                tree.add(key);
+            }
+        });
+        std::size_t hits = 0;
+        auto probe_seconds = time_seconds([&] {
+            for (const auto& probe : probes)
+            {
+                // Probe.
+                hits += tree.contains(probe);
+            }
+        });
+        report("hash-indexed tree", insert_seconds, probe_seconds, tree_bytes + tree.index_memory(), hits);
+    }
+
+    // Frozen sorted array (read-only layout).
+    {
+        std::vector< unsigned int > frozen;
+        auto insert_seconds = time_seconds([&] {
+            frozen = keys;
+            std::sort(frozen.begin(), frozen.end());
+        });
+        std::size_t hits = 0;
+        auto probe_seconds = time_seconds([&] {
+            for (const auto& probe : probes)
+            {
+                // Probe.
+                hits += std::binary_search(frozen.begin(), frozen.end(), probe);
+            }
+        });
+        report("frozen sorted array", insert_seconds, probe_seconds, frozen.capacity() * sizeof(unsigned int), hits);
+    }
+
+    // Padding and flush stream.
+    std::cout << '\n' << std::endl;
+
+    // Exit (success).
+    return 0;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // INDEX_BENCHMARK_CPP_
+//
\ No newline at end of file
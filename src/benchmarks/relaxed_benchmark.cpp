@@ -0,0 +1,201 @@
+/**
+ *
+ * @file relaxed_benchmark.cpp
+ *
+ * @brief Write-burst latency benchmark for relaxed rebalancing.
+ *
+ * @author Josh Wiley
+ *
+ * @details Adds a burst of ascending and of random keys to a strict tree, to
+ *          relaxed trees with different step budgets (0 relies on the queue
+ *          cap alone) and to a relaxed tree repaired by its background
+ *          maintenance thread, and reports the throughput, per-add latency
+ *          percentiles, the height right after the burst and the time
+ *          rebalance() takes to restore the bound. The maintenance thread
+ *          only pays off with a spare core; on one core it competes with the
+ *          writer for the CPU and the tree lock.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef RELAXED_BENCHMARK_CPP_
+#define RELAXED_BENCHMARK_CPP_
+#define BENCHMARK_BURST 500000
+#define BENCHMARK_MAINTENANCE_US 100
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <functional>
+#include "../RedBlackNode/RedBlackNode.h"
+#include "../RelaxedTree/RelaxedRedBlackTree.h"
+#include "../utils/latency_histogram.h"
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Adds every key, recording the latency of each add
+ *
+ * @param[in] keys
+ *            Keys to add.
+ *
+ * @param[in] add
+ *            Function adding one key.
+ *
+ * @param[out] histogram
+ *             Latencies (nanoseconds).
+ *
+ * @return Elapsed seconds
+ *
+ */
+double burst(const std::vector< unsigned int >& keys, std::function< void(unsigned int) > add, LatencyHistogram& histogram)
+{
+  // Time each add.
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& key : keys)
+  {
+    // Add.
+    auto add_start = std::chrono::steady_clock::now();
+    add(key);
+    histogram.record(std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now() - add_start).count());
+  }
+  return std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Prints one result row
+ *
+ * @param[in] name
+ *            Mode name.
+ *
+ * @param[in] seconds
+ *            Time taken by the burst.
+ *
+ * @param[in] histogram
+ *            Per-add latencies.
+ *
+ * @param[in] height
+ *            Height right after the burst.
+ *
+ * @param[in] rebalance_ms
+ *            Time taken by rebalance().
+ *
+ */
+void report(const std::string& name, double seconds, const LatencyHistogram& histogram, unsigned int height, double rebalance_ms)
+{
+  // Row.
+  std::cout << "  " << std::left << std::setw(18) << name << std::right
+            << std::setw(12) << (long) (BENCHMARK_BURST / seconds)
+            << std::fixed << std::setprecision(2)
+            << std::setw(9) << histogram.percentile(50) / 1000.0
+            << std::setw(9) << histogram.percentile(99) / 1000.0
+            << std::setw(9) << histogram.percentile(99.9) / 1000.0
+            << std::setw(10) << histogram.max() / 1000.0
+            << std::setw(8) << height
+            << std::setw(12) << rebalance_ms << '\n';
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Runs the burst against a relaxed tree and prints its row
+ *
+ * @param[in] keys
+ *            Keys to add.
+ *
+ * @param[in] budget
+ *            Fix-up steps after each add.
+ *
+ * @param[in] maintenance_us
+ *            Period of the background maintenance pass (0 disables).
+ *
+ * @param[in] name
+ *            Mode name.
+ *
+ */
+void relaxed(const std::vector< unsigned int >& keys, unsigned int budget, unsigned int maintenance_us, const std::string& name)
+{
+  // Burst.
+  RelaxedRedBlackTree< unsigned int > tree(budget, maintenance_us);
+  LatencyHistogram histogram;
+  auto seconds = burst(keys, [&] (unsigned int key) {
+    tree.add(key);
+  }, histogram);
+
+  // Repair the rest.
+  auto height = tree.height();
+  auto start = std::chrono::steady_clock::now();
+  tree.rebalance();
+  auto rebalance_ms = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - start).count();
+  report(name, seconds, histogram, height, rebalance_ms);
+}
+//
+//  Main Function Implementation  //////////////////////////////////////////////
+//
+int main()
+{
+    // Bursts.
+    std::vector< unsigned int > ascending(BENCHMARK_BURST);
+    std::vector< unsigned int > random(BENCHMARK_BURST);
+    std::mt19937 generator(13);
+    for (std::size_t i = 0; i < ascending.size(); i++)
+    {
+        // Generate.
+        ascending[i] = (unsigned int) i;
+        random[i] = generator();
+    }
+
+    // Each burst.
+    for (const auto* keys : { &ascending, &random })
+    {
+        // Header.
+        std::cout << "\n\n" << BENCHMARK_BURST << (keys == &ascending ? " ascending" : " random") << " adds:\n"
+                  << "  " << std::left << std::setw(18) << "mode" << std::right
+                  << std::setw(12) << "adds/s" << std::setw(9) << "p50 us" << std::setw(9) << "p99 us"
+                  << std::setw(9) << "p999 us" << std::setw(10) << "max us" << std::setw(8) << "height"
+                  << std::setw(12) << "rebal. ms" << '\n';
+
+        // Strict tree.
+        {
+            auto root_ptr = std::make_shared< RedBlackNode< unsigned int > >(nullptr, false);
+            LatencyHistogram histogram;
+            auto seconds = burst(*keys, [&] (unsigned int key) {
+                root_ptr->add(key);
+                root_ptr = root_ptr->root();
+            }, histogram);
+            report("strict", seconds, histogram, root_ptr->height(), 0);
+            root_ptr->clear();
+        }
+
+        // Relaxed trees.
+        for (unsigned int budget : { 0u, 2u, 4u, 8u })
+        {
+            relaxed(*keys, budget, 0, "relaxed budget " + std::to_string(budget));
+        }
+
+        // Relaxed tree with a background maintenance pass.
+        relaxed(*keys, 0, BENCHMARK_MAINTENANCE_US, "maintained " + std::to_string(BENCHMARK_MAINTENANCE_US) + " us");
+    }
+
+    // Padding and flush stream.
+    std::cout << '\n' << std::endl;
+
+    // Exit (success).
+    return 0;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // RELAXED_BENCHMARK_CPP_
+//
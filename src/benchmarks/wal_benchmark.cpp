@@ -0,0 +1,151 @@
+/**
+ *
+ * @file wal_benchmark.cpp
+ *
+ * @brief Insert throughput benchmark for the durable red-black tree.
+ *
+ * @author Josh Wiley
+ *
+ * @details Inserts the same random keys into a durable tree under several
+ *          group-commit (fsync) policies, then times recovery of the last one.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef WAL_BENCHMARK_CPP_
+#define WAL_BENCHMARK_CPP_
+#define BENCHMARK_SIZE 20000
+#define BENCHMARK_KEY_MAX 1000000
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include "../DurableTree/DurableRedBlackTree.h"
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Removes the files a durable tree leaves in a directory
+ *
+ * @param[in] directory
+ *            Directory to empty.
+ *
+ */
+void remove_durable_files(const std::string& directory)
+{
+  // Delete known files.
+  std::remove((directory + "/wal.log").c_str());
+  std::remove((directory + "/wal.log.old").c_str());
+  std::remove((directory + "/checkpoint").c_str());
+  std::remove((directory + "/checkpoint.tmp").c_str());
+}
+//
+//  Main Function Implementation  //////////////////////////////////////////////
+//
+int main()
+{
+    // Scratch directory.
+    char directory_template[] = "/tmp/rbt_wal_benchmark_XXXXXX";
+    if (!mkdtemp(directory_template))
+    {
+        // Abort.
+        std::cerr << "Unable to create scratch directory\n";
+        return 1;
+    }
+    std::string directory(directory_template);
+
+    // Test data.
+    std::mt19937 generator(42);
+    std::uniform_int_distribution< unsigned int > distribution(1, BENCHMARK_KEY_MAX);
+    std::vector< unsigned int > keys(BENCHMARK_SIZE);
+    for (auto& key : keys)
+    {
+        // Generate.
+        key = distribution(generator);
+    }
+
+    // Policies (operations, microseconds; 0 disables a bound).
+    struct Policy { const char* name; unsigned int ops; unsigned int us; };
+    const Policy policies[] = {
+        { "fsync every op", 1, 0 },
+        { "fsync every 16 ops", 16, 0 },
+        { "fsync every 256 ops", 256, 0 },
+        { "fsync every 100 us", 0, 100 },
+        { "fsync every 1000 us", 0, 1000 },
+        { "64 ops or 1000 us", 64, 1000 },
+        { "no fsync (log only)", 0, 0 }
+    };
+
+    // Header.
+    std::cout << "\n\nInsert throughput (" << BENCHMARK_SIZE << " keys):\n";
+
+    // Run policies.
+    for (const auto& policy : policies)
+    {
+        // Fresh directory.
+        remove_durable_files(directory);
+
+        // Configure.
+        DurabilityConfig config;
+        config.directory = directory;
+        config.sync_every_ops = policy.ops;
+        config.sync_every_us = policy.us;
+
+        // Time inserts.
+        DurableRedBlackTree< unsigned int > tree(config);
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& key : keys)
+        {
+            // Add.
+            tree.add(key);
+        }
+        tree.sync();
+        auto elapsed = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+
+        // Report.
+        std::cout << "  " << std::left << std::setw(22) << policy.name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(0)
+                  << BENCHMARK_SIZE / elapsed << " ops/s\n";
+    }
+
+    // Time recovery of the last run (checkpoint plus full log replay).
+    {
+        // Configure.
+        DurabilityConfig config;
+        config.directory = directory;
+
+        // Recover.
+        auto start = std::chrono::steady_clock::now();
+        DurableRedBlackTree< unsigned int > tree(config);
+        auto elapsed = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+
+        // Report.
+        std::cout << "\nRecovery of " << BENCHMARK_SIZE << " logged inserts: "
+                  << std::setprecision(2) << elapsed * 1000 << " ms";
+    }
+
+    // Clean up.
+    remove_durable_files(directory);
+    ::rmdir(directory.c_str());
+
+    // Padding and flush stream.
+    std::cout << '\n' << std::endl;
+
+    // Exit (success).
+    return 0;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // WAL_BENCHMARK_CPP_
+//
\ No newline at end of file
@@ -0,0 +1,947 @@
+/**
+ *
+ * @file tree_check.cpp
+ *
+ * @brief Invariant checks for the red-black tree modes.
+ *
+ * @author Josh Wiley
+ *
+ * @details Drives every tree mode with random operations and checks the
+ *          result against the red-black invariants (black root, no red node
+ *          with a red child, equal black heights, parent links, search order,
+ *          summaries recomputed from the values) and against a standard
+ *          container holding the same values. Each mode adds its own check
+ *          function to the table in main. Prints each failed check and exits
+ *          with a non-zero status.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef TREE_CHECK_CPP_
+#define TREE_CHECK_CPP_
+#define CHECK(condition) check((condition), #condition, __LINE__)
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <set>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <unistd.h>
+#include "RedBlackNode/RedBlackNode.h"
+#include "HashIndex/HashIndex.h"
+#include "IndexedTree/IndexedRedBlackTree.h"
+#include "IntervalTree/IntervalTree.h"
+#include "LeafBlockTree/LeafBlockTree.h"
+#include "RelaxedTree/RelaxedRedBlackTree.h"
+#include "DurableTree/DurableRedBlackTree.h"
+//
+//  Class Definitions  /////////////////////////////////////////////////////////
+//
+struct ClusterHash
+{
+  std::size_t operator()(unsigned int key) const { return key / 128; } /**< Same hash for each run of 128 keys (long, wrapping probe runs) */
+};
+//
+//  Global Variables  //////////////////////////////////////////////////////////
+//
+static unsigned int failures = 0; /**< Number of failed checks */
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Records a failed check
+ *
+ * @param[in] condition
+ *            Checked condition.
+ *
+ * @param[in] text
+ *            Source text of the condition.
+ *
+ * @param[in] line
+ *            Source line of the check.
+ *
+ */
+void check(bool condition, const char* text, int line)
+{
+  // Failed?
+  if (!condition)
+  {
+    // Report.
+    ++failures;
+    std::cerr << "tree_check.cpp:" << line << ": failed: " << text << '\n';
+  }
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Checks the sub-tree rooted at the node and collects its values
+ *
+ * @details Recomputes the summary from the values instead of trusting the
+ *          cached ones, so a summary missed by a rotation or fix-up is
+ *          caught at the node that holds it.
+ *
+ * @param[in] node_ptr
+ *            Root of the sub-tree.
+ *
+ * @param[out] values
+ *             Vector to append the values to, in-order.
+ *
+ * @param[out] summary
+ *             Summary of the sub-tree.
+ *
+ * @return Black height of the sub-tree
+ *
+ */
+template<class T, class A>
+unsigned int check_subtree(
+  const std::shared_ptr< RedBlackNode< T, A > >& node_ptr,
+  std::vector< T >& values,
+  typename A::summary_type& summary
+)
+{
+  // Empty?
+  if (node_ptr->empty())
+  {
+    // Black leaf.
+    CHECK(!node_ptr->is_red());
+    summary = A::identity();
+    return 0;
+  }
+
+  // Links and colors.
+  auto left_ptr = node_ptr->left_child();
+  auto right_ptr = node_ptr->right_child();
+  CHECK(left_ptr->parent() == node_ptr);
+  CHECK(right_ptr->parent() == node_ptr);
+  CHECK(!node_ptr->is_red() || (!left_ptr->is_red() && !right_ptr->is_red()));
+
+  // Sub-trees.
+  typename A::summary_type left_summary;
+  typename A::summary_type right_summary;
+  auto left_height = check_subtree(left_ptr, values, left_summary);
+  auto value = node_ptr->value();
+  CHECK(values.empty() || !(value < values.back()));
+  values.push_back(value);
+  auto right_height = check_subtree(right_ptr, values, right_summary);
+  CHECK(left_height == right_height);
+
+  // Summary.
+  summary = A::combine(A::combine(left_summary, A::lift(value)), right_summary);
+  CHECK(node_ptr->summary() == summary);
+
+  // Return black height.
+  return left_height + !node_ptr->is_red();
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Checks a whole tree against the invariants and the expected values
+ *
+ * @param[in] root_ptr
+ *            Root of the tree.
+ *
+ * @param[in] expected
+ *            Values the tree should hold, in order.
+ *
+ */
+template<class T, class A, class C>
+void check_tree(const std::shared_ptr< RedBlackNode< T, A > >& root_ptr, const C& expected)
+{
+  // Root.
+  CHECK(!root_ptr->parent());
+  CHECK(!root_ptr->is_red());
+
+  // Sub-trees.
+  std::vector< T > values;
+  typename A::summary_type summary;
+  check_subtree(root_ptr, values, summary);
+  CHECK(values == std::vector< T >(expected.begin(), expected.end()));
+
+  // Height bound.
+  CHECK(root_ptr->height() <= 2 * std::log2(values.size() + 1) + 1e-9);
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Random adds and removes (with duplicates) and range aggregates
+ *
+ */
+void check_add_remove()
+{
+  // Tree and reference.
+  std::mt19937 generator(1);
+  auto root_ptr = std::make_shared< RedBlackNode< unsigned int, SumAugment< unsigned int > > >(nullptr, false);
+  std::multiset< unsigned int > reference;
+
+  // Operations.
+  for (unsigned int i = 1; i <= 40000; i++)
+  {
+    // Add (60%) or remove.
+    auto key = generator() % 4000;
+    if (generator() % 10 < 6)
+    {
+      // Add.
+      CHECK(root_ptr->add(key));
+      reference.insert(key);
+    }
+    else
+    {
+      // Remove one copy.
+      auto key_it = reference.find(key);
+      CHECK(root_ptr->remove(key) == (key_it != reference.end()));
+      if (key_it != reference.end())
+      {
+        // Mirror.
+        reference.erase(key_it);
+      }
+    }
+    root_ptr = root_ptr->root();
+
+    // Check periodically.
+    if (i % 2000 == 0)
+    {
+      // Structure.
+      check_tree(root_ptr, reference);
+
+      // Range sums.
+      for (unsigned int j = 0; j < 20; j++)
+      {
+        // Random range.
+        auto low = generator() % 4000;
+        auto high = low + generator() % 1000;
+        long sum = 0;
+        for (auto key_it = reference.lower_bound(low); key_it != reference.end() && *key_it <= high; ++key_it)
+        {
+          // Brute force.
+          sum += *key_it;
+        }
+        CHECK(root_ptr->aggregate(low, high) == sum);
+      }
+    }
+  }
+
+  // Remove everything.
+  for (auto key : std::vector< unsigned int >(reference.begin(), reference.end()))
+  {
+    // Remove.
+    CHECK(root_ptr->remove(key));
+    root_ptr = root_ptr->root();
+  }
+  CHECK(root_ptr->empty());
+  check_tree(root_ptr, std::vector< unsigned int >());
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Sum, minimum and count of ranges from one composite-policy tree
+ *
+ */
+void check_range_stats()
+{
+  // Tree and reference.
+  std::mt19937 generator(8);
+  auto root_ptr = std::make_shared< RedBlackNode< int, RangeStatsAugment< int > > >(nullptr, false);
+  std::multiset< int > reference;
+
+  // Signed keys, so the minimum is not always near zero.
+  for (unsigned int i = 0; i < 10000; i++)
+  {
+    // Add, or remove one copy.
+    int key = (int) (generator() % 2000) - 1000;
+    if (generator() % 3)
+    {
+      // Add.
+      root_ptr->add(key);
+      reference.insert(key);
+    }
+    else if (reference.count(key))
+    {
+      // Remove.
+      CHECK(root_ptr->remove(key));
+      reference.erase(reference.find(key));
+    }
+    root_ptr = root_ptr->root();
+  }
+  check_tree(root_ptr, reference);
+
+  // Ranges, including empty ones.
+  for (unsigned int i = 0; i < 200; i++)
+  {
+    // Random range.
+    int low = (int) (generator() % 2200) - 1100;
+    int high = low + (int) (generator() % 300) - 20;
+
+    // Brute force.
+    long sum = 0;
+    int min = std::numeric_limits< int >::max();
+    unsigned long count = 0;
+    for (auto key_it = reference.lower_bound(low); key_it != reference.end() && *key_it <= high; ++key_it)
+    {
+      // Accumulate.
+      sum += *key_it;
+      min = std::min(min, *key_it);
+      ++count;
+    }
+
+    // One call.
+    auto summary = root_ptr->aggregate(low, high);
+    CHECK(std::get< 0 >(summary) == sum);
+    CHECK(std::get< 1 >(summary) == min);
+    CHECK(std::get< 2 >(summary) == count);
+  }
+
+  // Free.
+  root_ptr->clear();
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief String keys with long shared prefixes (cached key prefixes)
+ *
+ */
+void check_string_keys()
+{
+  // Tree and reference.
+  std::mt19937 generator(2);
+  auto root_ptr = std::make_shared< RedBlackNode< std::string, CountAugment< std::string > > >(nullptr, false);
+  std::multiset< std::string > reference;
+
+  // Operations.
+  for (unsigned int i = 0; i < 8000; i++)
+  {
+    // Keys agree on their first bytes, so order is decided past the cache.
+    auto key = std::string(generator() % 12, 'k') + std::to_string(generator() % 500);
+    if (generator() % 4)
+    {
+      // Add.
+      root_ptr->add(key);
+      reference.insert(key);
+    }
+    else if (reference.count(key))
+    {
+      // Remove one copy.
+      CHECK(root_ptr->remove(key));
+      reference.erase(reference.find(key));
+    }
+    root_ptr = root_ptr->root();
+  }
+
+  // Structure and counts.
+  check_tree(root_ptr, reference);
+  CHECK(root_ptr->aggregate("k", "kkkkkk~") == (unsigned long) std::distance(reference.lower_bound("k"), reference.upper_bound("kkkkkk~")));
+
+  // Free.
+  root_ptr->clear();
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Batch inserts into empty, small and large trees
+ *
+ */
+void check_insert_batch()
+{
+  // Shapes.
+  std::mt19937 generator(3);
+  for (unsigned int threads : { 1u, 2u, 3u, 8u })
+  {
+    for (std::size_t initial : { 0u, 100u, 20000u })
+    {
+      // Tree and reference.
+      auto root_ptr = std::make_shared< RedBlackNode< unsigned int, SumAugment< unsigned int > > >(nullptr, false);
+      std::multiset< unsigned int > reference;
+      for (std::size_t i = 0; i < initial; i++)
+      {
+        // Add.
+        auto key = generator() % 100000;
+        root_ptr->add(key);
+        root_ptr = root_ptr->root();
+        reference.insert(key);
+      }
+
+      // Batches (small ones take the sequential path).
+      for (std::size_t size : { 0u, 1000u, 30000u })
+      {
+        // Random batch with duplicates.
+        std::vector< unsigned int > batch(size);
+        for (auto& key : batch)
+        {
+          // Generate.
+          key = generator() % 100000;
+        }
+        std::set< unsigned int > distinct(batch.begin(), batch.end());
+
+        // Insert.
+        CHECK(root_ptr->insert_batch(batch.begin(), batch.end(), threads) == distinct.size());
+        root_ptr = root_ptr->root();
+        reference.insert(distinct.begin(), distinct.end());
+        check_tree(root_ptr, reference);
+      }
+
+      // Only the root may take a batch.
+      if (!root_ptr->empty())
+      {
+        // Non-root call.
+        auto is_rejected = false;
+        try
+        {
+          // Insert below the root.
+          std::vector< unsigned int > batch(1, 7);
+          root_ptr->left_child()->insert_batch(batch.begin(), batch.end(), threads);
+        }
+        catch (const std::invalid_argument&)
+        {
+          // Rejected.
+          is_rejected = true;
+        }
+        CHECK(is_rejected);
+        check_tree(root_ptr, reference);
+      }
+
+      // Free.
+      root_ptr->clear();
+    }
+  }
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Relaxed rebalancing with every step budget, sorted and random keys
+ *
+ */
+void check_relaxed()
+{
+  // Budgets (0 and 1 rely on the pending bound).
+  std::mt19937 generator(4);
+  for (unsigned int budget : { 0u, 1u, 2u, 4u })
+  {
+    // Tree and reference.
+    RelaxedRedBlackTree< unsigned int, SumAugment< unsigned int > > tree(budget);
+    std::multiset< unsigned int > reference;
+
+    // Sorted burst, then random keys.
+    for (unsigned int i = 0; i < 20000; i++)
+    {
+      // Add.
+      auto key = i < 10000 ? i : generator() % 20000;
+      tree.add(key);
+      reference.insert(key);
+
+      // Height bound while violations are queued.
+      if (i % 500 == 0)
+      {
+        // Check.
+        CHECK(tree.pending() <= RELAXED_MAX_PENDING);
+        CHECK(tree.height() <= 2 * std::log2(reference.size() + 1) + 1 + RELAXED_MAX_PENDING);
+        CHECK(tree.aggregate(100, 200) == tree.root()->aggregate(100, 200));
+      }
+
+      // Occasional remove (drains the queue first).
+      if (i % 7 == 0)
+      {
+        // Remove one copy.
+        auto key_it = reference.find(generator() % 20000);
+        if (key_it != reference.end())
+        {
+          // Mirror.
+          CHECK(tree.remove(*key_it));
+          reference.erase(key_it);
+        }
+      }
+    }
+
+    // Repair everything.
+    tree.rebalance();
+    CHECK(tree.pending() == 0);
+    check_tree(tree.root(), reference);
+  }
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Background maintenance repairs a burst without rebalance()
+ *
+ */
+void check_relaxed_maintenance()
+{
+  // Tree (no per-add repairs; the thread does them) and reference.
+  std::mt19937 generator(11);
+  RelaxedRedBlackTree< unsigned int, SumAugment< unsigned int > > tree(0, 50);
+  std::multiset< unsigned int > reference;
+
+  // Burst racing the maintenance thread.
+  for (unsigned int i = 0; i < 20000; i++)
+  {
+    // Sorted, then random keys.
+    auto key = i < 10000 ? i : generator() % 20000;
+    tree.add(key);
+    reference.insert(key);
+    CHECK(tree.pending() <= RELAXED_MAX_PENDING);
+
+    // Occasional remove.
+    if (i % 11 == 0)
+    {
+      // Remove one copy.
+      auto key_it = reference.find(generator() % 20000);
+      if (key_it != reference.end())
+      {
+        // Mirror.
+        CHECK(tree.remove(*key_it));
+        reference.erase(key_it);
+      }
+    }
+  }
+
+  // Wait for the thread to drain the queue (up to 5 s).
+  for (unsigned int i = 0; i < 5000 && tree.pending(); i++)
+  {
+    // Sleep.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  CHECK(tree.pending() == 0);
+
+  // Repaired tree (the idle thread no longer touches it).
+  check_tree(tree.root(), reference);
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Hash index counts against a multiset, with clustered hashes
+ *
+ * @details Runs of 128 keys share a hash, so probe runs are long and wrap past
+ *          the end of the slot array, and erases shift entries back across
+ *          the wrap. The index grows from its initial size along the way.
+ *
+ */
+void check_hash_index()
+{
+  // Index and reference.
+  std::mt19937 generator(9);
+  HashIndex< unsigned int, ClusterHash > index;
+  std::multiset< unsigned int > reference;
+
+  // Grow while adding, then drain.
+  for (unsigned int i = 0; i < 60000; i++)
+  {
+    // Insert (with duplicates) or erase.
+    auto key = generator() % 3000;
+    if (i < 30000 ? generator() % 3 != 0 : generator() % 3 == 0)
+    {
+      // Insert.
+      index.insert(key);
+      reference.insert(key);
+    }
+    else
+    {
+      // Erase one copy.
+      auto key_it = reference.find(key);
+      CHECK(index.erase(key) == (key_it != reference.end()));
+      if (key_it != reference.end())
+      {
+        // Mirror.
+        reference.erase(key_it);
+      }
+    }
+
+    // Every key, periodically.
+    if (i % 5000 == 0)
+    {
+      // Counts.
+      for (unsigned int key = 0; key < 3000; key++)
+      {
+        // Compare.
+        CHECK(index.count(key) == reference.count(key));
+      }
+      CHECK(index.size() == std::set< unsigned int >(reference.begin(), reference.end()).size());
+    }
+  }
+
+  // Clear.
+  index.clear();
+  CHECK(index.size() == 0);
+  CHECK(!index.contains(reference.empty() ? 0 : *reference.begin()));
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Indexed tree kept in sync with its index through add/remove/clear
+ *
+ */
+void check_indexed_tree()
+{
+  // Tree and reference.
+  std::mt19937 generator(10);
+  IndexedRedBlackTree< unsigned int, SumAugment< unsigned int >, ClusterHash > tree;
+  std::multiset< unsigned int > reference;
+
+  // Two rounds, cleared in between.
+  for (unsigned int round = 0; round < 2; round++)
+  {
+    // Operations.
+    for (unsigned int i = 0; i < 20000; i++)
+    {
+      // Add or remove one copy.
+      auto key = generator() % 2000;
+      if (generator() % 5 < 3)
+      {
+        // Add.
+        CHECK(tree.add(key));
+        reference.insert(key);
+      }
+      else
+      {
+        // Remove.
+        auto key_it = reference.find(key);
+        CHECK(tree.remove(key) == (key_it != reference.end()));
+        if (key_it != reference.end())
+        {
+          // Mirror.
+          reference.erase(key_it);
+        }
+      }
+    }
+
+    // Index.
+    for (unsigned int key = 0; key < 2000; key++)
+    {
+      // Compare.
+      CHECK(tree.count(key) == reference.count(key));
+      CHECK(tree.contains(key) == (reference.count(key) != 0));
+    }
+
+    // Tree.
+    std::vector< unsigned int > values;
+    tree.each_inorder([&values] (std::shared_ptr< unsigned int > value_ptr) { values.push_back(*value_ptr); });
+    CHECK(values == std::vector< unsigned int >(reference.begin(), reference.end()));
+    CHECK(tree.root()->total_nodes() == reference.size());
+    CHECK(tree.aggregate(0, 999) == tree.root()->aggregate(0, 999));
+    CHECK(tree.root()->height() <= 2 * std::log2(reference.size() + 1) + 1e-9);
+
+    // Clear.
+    tree.clear();
+    reference.clear();
+    CHECK(tree.empty());
+    CHECK(!tree.contains(0));
+    CHECK(tree.root()->empty());
+  }
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Interval tree overlap queries against a brute-force scan
+ *
+ */
+void check_intervals()
+{
+  // Tree and reference.
+  std::mt19937 generator(5);
+  auto root_ptr = std::make_shared< IntervalNode< unsigned int > >(nullptr, false);
+  std::multiset< Interval< unsigned int > > reference;
+
+  // Intervals of mixed lengths.
+  for (unsigned int i = 0; i < 5000; i++)
+  {
+    // Add.
+    unsigned int low = generator() % 100000;
+    unsigned int length = generator() % 10 ? generator() % 100 : generator() % 20000;
+    Interval< unsigned int > interval{ low, low + length };
+    root_ptr->add(interval);
+    root_ptr = root_ptr->root();
+    reference.insert(interval);
+
+    // Remove some.
+    if (i % 5 == 0)
+    {
+      // Remove smallest.
+      CHECK(root_ptr->remove(*reference.begin()));
+      root_ptr = root_ptr->root();
+      reference.erase(reference.begin());
+    }
+  }
+  check_tree(root_ptr, reference);
+
+  // Queries.
+  for (unsigned int i = 0; i < 200; i++)
+  {
+    // Random query.
+    unsigned int low = generator() % 100000;
+    unsigned int length = generator() % 500;
+    Interval< unsigned int > query{ low, low + length };
+
+    // Brute force.
+    std::vector< Interval< unsigned int > > expected;
+    for (const auto& interval : reference)
+    {
+      // Keep overlaps.
+      if (interval.overlaps(query))
+      {
+        expected.push_back(interval);
+      }
+    }
+
+    // Lazy enumeration.
+    std::vector< Interval< unsigned int > > found;
+    for (const auto& interval : interval_tree::overlapping(root_ptr, query))
+    {
+      // Collect.
+      found.push_back(interval);
+    }
+    CHECK(found == expected);
+    CHECK(interval_tree::any_overlap(root_ptr, query) == !expected.empty());
+  }
+
+  // Free.
+  root_ptr->clear();
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Leaf block tree splits, merges and clear against a set
+ *
+ */
+void check_leaf_blocks()
+{
+  // Tree and reference.
+  std::mt19937 generator(6);
+  LeafBlockTree< unsigned int > tree;
+  std::set< unsigned int > reference;
+
+  // Grow, then shrink.
+  for (unsigned int i = 0; i < 60000; i++)
+  {
+    // Add while growing, mostly remove afterwards.
+    auto key = generator() % 20000;
+    if (i < 30000 ? generator() % 4 != 0 : generator() % 4 == 0)
+    {
+      // Add.
+      CHECK(tree.add(key) == reference.insert(key).second);
+    }
+    else
+    {
+      // Remove.
+      CHECK(tree.remove(key) == (reference.erase(key) == 1));
+    }
+  }
+
+  // Contents.
+  std::vector< unsigned int > values;
+  tree.each_inorder([&values] (std::shared_ptr< unsigned int > value_ptr) { values.push_back(*value_ptr); });
+  CHECK(values == std::vector< unsigned int >(reference.begin(), reference.end()));
+  CHECK(tree.size() == reference.size());
+  for (unsigned int key = 0; key < 20000; key += 7)
+  {
+    // Membership.
+    CHECK(tree.contains(key) == (reference.count(key) == 1));
+  }
+
+  // Clear and reuse.
+  tree.clear();
+  CHECK(tree.empty() && tree.block_count() == 1 && !tree.contains(*reference.begin()));
+  CHECK(tree.add(5) && tree.contains(5) && tree.size() == 1);
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Returns the values of a durable tree in order
+ *
+ * @param[in] tree
+ *            Tree to read.
+ *
+ * @return Values
+ *
+ */
+std::vector< unsigned int > durable_values(DurableRedBlackTree< unsigned int >& tree)
+{
+  // Collect.
+  std::vector< unsigned int > values;
+  tree.each_inorder([&values] (std::shared_ptr< unsigned int > value_ptr) { values.push_back(*value_ptr); });
+  return values;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Write-ahead log recovery across compactions, concurrent checkpoints
+ *        and a torn tail
+ *
+ */
+void check_recovery()
+{
+  // Scratch directory.
+  char directory_template[] = "/tmp/rbt_tree_check_XXXXXX";
+  if (!mkdtemp(directory_template))
+  {
+    // Unable to run.
+    CHECK(!"mkdtemp");
+    return;
+  }
+  DurabilityConfig config;
+  config.directory = directory_template;
+  config.sync_every_ops = 16;
+  config.sync_every_us = 500;
+  config.compact_after_bytes = 4096;
+
+  // Logged operations (small compaction threshold, so logs rotate).
+  std::mt19937 generator(7);
+  std::multiset< unsigned int > reference;
+  {
+    DurableRedBlackTree< unsigned int > tree(config);
+    for (unsigned int i = 0; i < 5000; i++)
+    {
+      // Add or remove.
+      auto key = generator() % 1000;
+      if (generator() % 3)
+      {
+        // Add.
+        tree.add(key);
+        reference.insert(key);
+      }
+      else if (tree.remove(key))
+      {
+        // Mirror.
+        reference.erase(reference.find(key));
+      }
+    }
+    tree.checkpoint();
+    for (unsigned int key = 0; key < 100; key++)
+    {
+      // Logged after the checkpoint.
+      tree.add(key);
+      reference.insert(key);
+    }
+
+    // Writers racing checkpoints (rotations land mid-commit).
+    std::vector< std::thread > writers;
+    for (unsigned int writer = 0; writer < 2; writer++)
+    {
+      // Distinct keys per writer.
+      writers.emplace_back([&tree, writer] {
+        for (unsigned int key = 0; key < 2000; key++)
+        {
+          // Add.
+          tree.add(10000 + writer * 10000 + key);
+        }
+      });
+    }
+    for (unsigned int i = 0; i < 20; i++)
+    {
+      // Checkpoint.
+      tree.checkpoint();
+    }
+    for (auto& writer : writers)
+    {
+      // Wait.
+      writer.join();
+    }
+    for (unsigned int key = 0; key < 2000; key++)
+    {
+      // Mirror.
+      reference.insert(10000 + key);
+      reference.insert(20000 + key);
+    }
+  }
+
+  // Recover.
+  {
+    DurableRedBlackTree< unsigned int > tree(config);
+    CHECK(durable_values(tree) == std::vector< unsigned int >(reference.begin(), reference.end()));
+    tree.add(424242);
+    reference.insert(424242);
+  }
+
+  // Torn tail (a crash mid-write).
+  {
+    std::ofstream log(config.directory + "/wal.log", std::ios::binary | std::ios::app);
+    log << "torn";
+  }
+  {
+    DurableRedBlackTree< unsigned int > tree(config);
+    CHECK(durable_values(tree) == std::vector< unsigned int >(reference.begin(), reference.end()));
+  }
+
+  // Clean up.
+  for (const char* name : { "/wal.log", "/wal.log.old", "/checkpoint", "/checkpoint.tmp" })
+  {
+    // Remove.
+    std::remove((config.directory + name).c_str());
+  }
+  rmdir(directory_template);
+}
+//
+//  Main Function Implementation  //////////////////////////////////////////////
+//
+int main()
+{
+    // Checks.
+    std::vector< std::pair< const char*, void (*)() > > checks = {
+        { "add/remove and aggregates", check_add_remove },
+        { "composite range stats", check_range_stats },
+        { "string keys", check_string_keys },
+        { "insert_batch", check_insert_batch },
+        { "relaxed rebalancing", check_relaxed },
+        { "relaxed maintenance thread", check_relaxed_maintenance },
+        { "hash index", check_hash_index },
+        { "indexed tree", check_indexed_tree },
+        { "interval tree", check_intervals },
+        { "leaf block tree", check_leaf_blocks },
+        { "write-ahead log recovery", check_recovery }
+    };
+
+    // Run.
+    for (const auto& entry : checks)
+    {
+        // Check and report.
+        auto previous = failures;
+        entry.second();
+        std::cout << "  " << entry.first << ": " << (failures == previous ? "ok" : "FAILED") << std::endl;
+    }
+
+    // Exit (failure if any check failed).
+    return failures ? 1 : 0;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#undef CHECK
+#endif // TREE_CHECK_CPP_
+//
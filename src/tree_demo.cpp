@@ -0,0 +1,108 @@
+/**
+ *
+ * @file tree_demo.cpp
+ *
+ * @brief Demo of the red-black tree modes.
+ *
+ * @author Josh Wiley
+ *
+ * @details Generates random data and exercises the augmented red-black tree,
+ *          the interval tree and the leaf block (hybrid) tree on it.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef TREE_DEMO_CPP_
+#define TREE_DEMO_CPP_
+#define DATA_SET_SIZE 1000
+#define DATA_SET_MIN 1
+#define DATA_SET_MAX 10000
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <iostream>
+#include <memory>
+#include <algorithm>
+#include "utils/data_generator.h"
+#include "RedBlackNode/RedBlackNode.h"
+#include "IntervalTree/IntervalTree.h"
+#include "LeafBlockTree/LeafBlockTree.h"
+//
+//  Main Function Implementation  //////////////////////////////////////////////
+//
+int main()
+{
+    // Red-black tree.
+    auto rbt_root_ptr = std::make_shared< RedBlackNode< unsigned int, SumAugment< unsigned int > > >(nullptr, false);
+
+    // Test data.
+    auto data_set_ptr = std::make_shared< std::list< unsigned int > >();
+
+    // Generate test data.
+    data_generator::generate_random_data(
+        DATA_SET_SIZE,
+        DATA_SET_MIN,
+        DATA_SET_MAX,
+        data_set_ptr
+    );
+
+    // Build tree.
+    for (const auto& value : *data_set_ptr)
+    {
+        // Add item and update root.
+        rbt_root_ptr->add(value);
+        rbt_root_ptr = rbt_root_ptr->root();
+    }
+
+    // Display height.
+    std::cout << "\n\nRBT height: " << rbt_root_ptr->height();
+
+    // Display sum.
+    std::cout << "\n\nRBT sum: " << rbt_root_ptr->summary();
+
+    // Display range sum.
+    std::cout << "\n\nRBT sum of [" << DATA_SET_MIN << ", " << DATA_SET_MAX / 2 << "]: "
+              << rbt_root_ptr->aggregate(DATA_SET_MIN, DATA_SET_MAX / 2);
+
+    // Interval tree (each value starts an interval of width 10).
+    auto it_root_ptr = std::make_shared< IntervalNode< unsigned int > >(nullptr, false);
+    rbt_root_ptr->each_inorder([&it_root_ptr] (std::shared_ptr< unsigned int > i) {
+        it_root_ptr->add(Interval< unsigned int >{ *i, *i + 10 });
+        it_root_ptr = it_root_ptr->root();
+    });
+
+    // Display overlaps.
+    Interval< unsigned int > query{ DATA_SET_MAX / 2, DATA_SET_MAX / 2 + 20 };
+    std::cout << "\n\nIntervals overlapping [" << query.low << ", " << query.high << "]:";
+    for (const auto& interval : interval_tree::overlapping(it_root_ptr, query))
+    {
+        // Display.
+        std::cout << " [" << interval.low << ", " << interval.high << "]";
+    }
+    std::cout << "\n\nAny overlap: " << interval_tree::any_overlap(it_root_ptr, query);
+
+    // Hybrid tree (leaf blocks of sorted keys).
+    LeafBlockTree< unsigned int > hybrid_tree;
+    for (const auto& value : *data_set_ptr)
+    {
+        // Add.
+        hybrid_tree.add(value);
+    }
+
+    // Display hybrid shape.
+    std::cout << "\n\nHybrid height: " << hybrid_tree.height()
+              << " (" << hybrid_tree.size() << " unique keys in "
+              << hybrid_tree.block_count() << " blocks)";
+
+    // Padding and flush stream.
+    std::cout << '\n' << std::endl;
+
+    // Exit (success).
+    return 0;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // TREE_DEMO_CPP_
+//
@@ -0,0 +1,228 @@
+/**
+ *
+ * @file latency_histogram.cpp
+ *
+ * @brief Latency histogram class implementation.
+ *
+ * @author Josh Wiley
+ *
+ * @details Implements the LatencyHistogram class. A value below twice the
+ *          sub-bucket count has its own bucket; a larger value is shifted
+ *          right until it fits in [SUB_BUCKETS, 2 * SUB_BUCKETS), and the shift
+ *          (magnitude) selects the group of buckets it lands in.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef LATENCY_HISTOGRAM_CPP_
+#define LATENCY_HISTOGRAM_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <algorithm>
+#include <cmath>
+#include "latency_histogram.h"
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Default initializes an empty histogram covering every 64-bit value
+ *
+ */
+LatencyHistogram::LatencyHistogram()
+    : counts_(bucket_of(UINT64_MAX) + 1, 0),
+      total_(0),
+      max_(0),
+      sum_(0) {}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the number of recorded values
+ *
+ * @return Number of values
+ *
+ */
+std::uint64_t LatencyHistogram::count() const
+{
+    // Return total.
+    return total_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the largest recorded value
+ *
+ * @return Largest value (0 if none)
+ *
+ */
+std::uint64_t LatencyHistogram::max() const
+{
+    // Return max.
+    return max_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the mean of the recorded values
+ *
+ * @return Mean (0 if none)
+ *
+ */
+double LatencyHistogram::mean() const
+{
+    // Average.
+    return total_ ? sum_ / total_ : 0;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Walks the buckets until the given share of values is covered and
+ *          returns the largest value of that bucket (never above the largest
+ *          recorded value)
+ *
+ * @param[in] percentage
+ *            Percentage in [0, 100], e.g. 99.9.
+ *
+ * @return Value at the percentile (0 if none)
+ *
+ */
+std::uint64_t LatencyHistogram::percentile(double percentage) const
+{
+    // Empty?
+    if (total_ == 0)
+    {
+        // No value.
+        return 0;
+    }
+
+    // Rank to reach (at least the first value).
+    auto rank = std::max< std::uint64_t >(1, (std::uint64_t) std::ceil(percentage / 100 * total_));
+
+    // Walk buckets.
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts_.size(); i++)
+    {
+        // Reached?
+        seen += counts_[i];
+        if (seen >= rank)
+        {
+            // Bucket edge.
+            return std::min(highest_in(i), max_);
+        }
+    }
+
+    // Every value.
+    return max_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Records one value
+ *
+ * @param[in] value
+ *            Value (nanoseconds).
+ *
+ */
+void LatencyHistogram::record(std::uint64_t value)
+{
+    // Count.
+    ++counts_[bucket_of(value)];
+    ++total_;
+    max_ = std::max(max_, value);
+    sum_ += value;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Adds every value recorded by another histogram
+ *
+ * @param[in] other
+ *            Histogram to add.
+ *
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    // Add buckets.
+    for (std::size_t i = 0; i < counts_.size(); i++)
+    {
+        // Add.
+        counts_[i] += other.counts_[i];
+    }
+
+    // Add totals.
+    total_ += other.total_;
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the bucket holding the value
+ *
+ * @param[in] value
+ *            Value.
+ *
+ * @return Bucket index
+ *
+ */
+std::size_t LatencyHistogram::bucket_of(std::uint64_t value)
+{
+    // Small values are exact.
+    if (value < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        // Own bucket.
+        return (std::size_t) value;
+    }
+
+    // Shift until the value fits the sub-buckets.
+    unsigned int magnitude = 63 - __builtin_clzll(value) - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    return (std::size_t) magnitude * LATENCY_HISTOGRAM_SUB_BUCKETS + (std::size_t) (value >> magnitude);
+}
+//
+//  Class Member Implementation  ///////////////////////////////////////////////
+//
+/**
+ *
+ * @details Returns the largest value the bucket holds
+ *
+ * @param[in] bucket
+ *            Bucket index.
+ *
+ * @return Largest value of the bucket
+ *
+ */
+std::uint64_t LatencyHistogram::highest_in(std::size_t bucket)
+{
+    // Small values are exact.
+    if (bucket < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        // Own bucket.
+        return bucket;
+    }
+
+    // Undo the shift.
+    auto magnitude = bucket / LATENCY_HISTOGRAM_SUB_BUCKETS - 1;
+    auto sub_bucket = (std::uint64_t) (bucket - magnitude * LATENCY_HISTOGRAM_SUB_BUCKETS);
+    return ((sub_bucket + 1) << magnitude) - 1;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // LATENCY_HISTOGRAM_CPP_
+//
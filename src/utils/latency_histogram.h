@@ -0,0 +1,58 @@
+/**
+ *
+ * @file latency_histogram.h
+ *
+ * @brief Latency histogram class definition.
+ *
+ * @author Josh Wiley
+ *
+ * @details Defines the LatencyHistogram class, an HDR-style log-linear
+ *          histogram of nanosecond latencies. Each power-of-two range is
+ *          split into LATENCY_HISTOGRAM_SUB_BUCKETS linear buckets, so any
+ *          recorded value is reported within 1% over the full 64-bit range,
+ *          in a fixed array with O(1) recording.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS 7
+#define LATENCY_HISTOGRAM_SUB_BUCKETS (1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <vector>
+#include <cstdint>
+//
+//  Class Definition  //////////////////////////////////////////////////////////
+//
+class LatencyHistogram
+{
+// Public members.
+public:
+    LatencyHistogram(); /**< Default constructor */
+
+    std::uint64_t count() const; /**< Returns the number of recorded values */
+    std::uint64_t max() const; /**< Returns the largest recorded value */
+    double mean() const; /**< Returns the mean of the recorded values */
+    std::uint64_t percentile(double) const; /**< Returns the value at or below which the given percentage of values fall */
+    void record(std::uint64_t); /**< Records one value */
+    void merge(const LatencyHistogram&); /**< Adds every value recorded by another histogram */
+
+// Private members.
+private:
+    std::vector< std::uint64_t > counts_; /**< Count per bucket */
+    std::uint64_t total_; /**< Number of recorded values */
+    std::uint64_t max_; /**< Largest recorded value */
+    double sum_; /**< Sum of recorded values */
+
+    static std::size_t bucket_of(std::uint64_t); /**< Returns the bucket holding the value */
+    static std::uint64_t highest_in(std::size_t); /**< Returns the largest value the bucket holds */
+};
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // LATENCY_HISTOGRAM_H_
+//
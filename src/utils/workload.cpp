@@ -0,0 +1,354 @@
+/**
+ *
+ * @file workload.cpp
+ *
+ * @brief Implements workload description utilities.
+ *
+ * @author Josh Wiley
+ *
+ * @details Configuration and trace files are line based; blank lines and
+ *          text after '#' are ignored. Malformed input throws with the file
+ *          and line number so a bad trace is never half-replayed.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef WORKLOAD_CPP_
+#define WORKLOAD_CPP_
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <stdexcept>
+#include "workload.h"
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Parses a decimal number no greater than the limit
+ *
+ * @details Only digits are accepted, so a sign (which std::stoul would
+ *          accept and wrap), blanks or a base prefix make the text invalid.
+ *
+ * @param[in] text
+ *            Text to parse.
+ *
+ * @param[in] limit
+ *            Largest accepted value.
+ *
+ * @param[out] number
+ *             Parsed value.
+ *
+ * @return Boolean value indicating success
+ *
+ */
+static bool parse_number(const std::string& text, unsigned long long limit, unsigned long long& number)
+{
+  // Digits only?
+  if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos)
+  {
+    // Malformed.
+    return false;
+  }
+
+  // Parse.
+  try
+  {
+    // Convert.
+    number = std::stoull(text);
+  }
+  catch (const std::out_of_range&)
+  {
+    // Too large.
+    return false;
+  }
+
+  // In range?
+  return number <= limit;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Returns the trace keyword of the operation
+ *
+ * @param[in] operation
+ *            Operation type.
+ *
+ * @return Keyword
+ *
+ */
+const char* workload::name(Operation operation)
+{
+  // Keywords.
+  static const char* names[OPERATION_COUNT] = { "add", "contains", "remove", "range" };
+  return names[operation];
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Applies one key=value setting
+ *
+ * @details Each value must fit its field: threads in [1,
+ *          WORKLOAD_MAX_THREADS], key_space at least 1 and each share of
+ *          the mix at most 100.
+ *
+ * @param[in,out] config
+ *                Configuration to update.
+ *
+ * @param[in] setting
+ *            Setting text, e.g. "threads=4".
+ *
+ */
+void workload::set(Config& config, const std::string& setting)
+{
+  // Split.
+  auto split = setting.find('=');
+  if (split == std::string::npos)
+  {
+    // Malformed.
+    throw std::invalid_argument("expected key=value: " + setting);
+  }
+  auto key = setting.substr(0, split);
+  auto value = setting.substr(split + 1);
+
+  // Trace path?
+  if (key == "trace")
+  {
+    // Set.
+    config.trace = value;
+    return;
+  }
+
+  // Bounds of the field.
+  unsigned long long low = 0;
+  unsigned long long high = UINT_MAX;
+  if (key == "threads") { low = 1; high = WORKLOAD_MAX_THREADS; }
+  else if (key == "operations" || key == "preload") high = SIZE_MAX;
+  else if (key == "key_space") low = 1;
+  else if (key == "add" || key == "contains" || key == "remove" || key == "range") high = 100;
+  else if (key != "range_width" && key != "seed") throw std::invalid_argument("unknown setting: " + key);
+
+  // Numeric value.
+  unsigned long long number = 0;
+  if (!parse_number(value, high, number) || number < low)
+  {
+    // Malformed or out of range.
+    throw std::invalid_argument(
+      "expected a number in [" + std::to_string(low) + ", " + std::to_string(high) + "]: " + setting
+    );
+  }
+
+  // Assign.
+  if (key == "threads") config.threads = number;
+  else if (key == "operations") config.operations = number;
+  else if (key == "preload") config.preload = number;
+  else if (key == "key_space") config.key_space = number;
+  else if (key == "range_width") config.range_width = number;
+  else if (key == "add") config.add_percent = number;
+  else if (key == "contains") config.contains_percent = number;
+  else if (key == "remove") config.remove_percent = number;
+  else if (key == "range") config.range_percent = number;
+  else config.seed = number;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Applies every key=value line of a configuration file
+ *
+ * @param[in,out] config
+ *                Configuration to update.
+ *
+ * @param[in] path
+ *            Path of the file.
+ *
+ */
+void workload::load_config(Config& config, const std::string& path)
+{
+  // Open.
+  std::ifstream file(path);
+  if (!file)
+  {
+    // Missing.
+    throw std::runtime_error("cannot open config " + path);
+  }
+
+  // Each line.
+  std::string line;
+  for (std::size_t number = 1; std::getline(file, line); number++)
+  {
+    // Strip comment and blanks.
+    std::istringstream words(line.substr(0, line.find('#')));
+    std::string setting;
+    if (!(words >> setting))
+    {
+      // Blank.
+      continue;
+    }
+
+    // Apply.
+    try
+    {
+      // Set.
+      set(config, setting);
+    }
+    catch (const std::invalid_argument& error)
+    {
+      // Locate.
+      throw std::runtime_error(path + ":" + std::to_string(number) + ": " + error.what());
+    }
+  }
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Parses a recorded trace
+ *
+ * @param[in] path
+ *            Path of the trace file.
+ *
+ * @return Operations in trace order
+ *
+ */
+std::vector< workload::Step > workload::load_trace(const std::string& path)
+{
+  // Open.
+  std::ifstream file(path);
+  if (!file)
+  {
+    // Missing.
+    throw std::runtime_error("cannot open trace " + path);
+  }
+
+  // Each line.
+  std::vector< Step > steps;
+  std::string line;
+  for (std::size_t number = 1; std::getline(file, line); number++)
+  {
+    // Strip comment and blanks.
+    std::istringstream words(line.substr(0, line.find('#')));
+    std::string keyword;
+    if (!(words >> keyword))
+    {
+      // Blank.
+      continue;
+    }
+
+    // Operation.
+    Step step{ OPERATION_COUNT, 0, 0 };
+    for (unsigned int i = 0; i < OPERATION_COUNT; i++)
+    {
+      // Match keyword.
+      if (keyword == name((Operation) i))
+      {
+        // Found.
+        step.operation = (Operation) i;
+      }
+    }
+
+    // Operands (unsigned, so parsed as text: stream extraction wraps a sign).
+    std::string key_text;
+    std::string high_text = "0";
+    std::string rest;
+    unsigned long long key = 0;
+    unsigned long long high = 0;
+    bool is_valid = step.operation != OPERATION_COUNT && (words >> key_text);
+    if (is_valid && step.operation == RANGE)
+    {
+      // High bound.
+      is_valid = (bool) (words >> high_text);
+    }
+    is_valid = is_valid && parse_number(key_text, UINT_MAX, key) && parse_number(high_text, UINT_MAX, high);
+    if (!is_valid || (words >> rest))
+    {
+      // Malformed.
+      throw std::runtime_error(path + ":" + std::to_string(number) + ": bad operation: " + line);
+    }
+
+    // Keep.
+    step.key = key;
+    step.high = high;
+    steps.push_back(step);
+  }
+
+  // Return steps.
+  return steps;
+}
+//
+//  Function Implementation  ///////////////////////////////////////////////////
+//
+/**
+ *
+ * @brief Generates the configured random operation mix
+ *
+ * @details Keys are uniform over the key space; each operation type is drawn
+ *          with weight equal to its configured percentage.
+ *
+ * @param[in] config
+ *            Workload configuration.
+ *
+ * @return Operations
+ *
+ */
+std::vector< workload::Step > workload::generate(const Config& config)
+{
+  // Weights.
+  unsigned int weights[OPERATION_COUNT] = {
+    config.add_percent,
+    config.contains_percent,
+    config.remove_percent,
+    config.range_percent
+  };
+  unsigned int total = weights[ADD] + weights[CONTAINS] + weights[REMOVE] + weights[RANGE];
+  if (total == 0)
+  {
+    // Nothing to draw.
+    throw std::invalid_argument("operation mix is empty");
+  }
+
+  // Generators.
+  std::mt19937 generator(config.seed);
+  std::uniform_int_distribution< unsigned int > keys(0, config.key_space - 1);
+  std::uniform_int_distribution< unsigned int > draws(0, total - 1);
+
+  // Generate.
+  std::vector< Step > steps(config.operations);
+  for (auto& step : steps)
+  {
+    // Type.
+    auto draw = draws(generator);
+    unsigned int type = 0;
+    while (draw >= weights[type])
+    {
+      // Next type.
+      draw -= weights[type++];
+    }
+
+    // Operands.
+    step.operation = (Operation) type;
+    step.key = keys(generator);
+    step.high = step.key > UINT_MAX - config.range_width ? UINT_MAX : step.key + config.range_width;
+  }
+
+  // Return steps.
+  return steps;
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // WORKLOAD_CPP_
+//
@@ -0,0 +1,85 @@
+/**
+ *
+ * @file workload.h
+ *
+ * @brief Namespace for workload description utilities.
+ *
+ * @author Josh Wiley
+ *
+ * @details Provides the operations a workload is made of, its configuration
+ *          (read from key=value files or arguments), and functions that load
+ *          a recorded trace or generate a synthetic operation mix.
+ *
+ */
+//
+//  Preprocessor Directives  ///////////////////////////////////////////////////
+//
+#ifndef WORKLOAD_H_
+#define WORKLOAD_H_
+#define WORKLOAD_MAX_THREADS 256
+//
+//  Header Files  //////////////////////////////////////////////////////////////
+//
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+//
+//  Namespace Definition  //////////////////////////////////////////////////////
+//
+namespace workload
+{
+  // Operation type.
+  enum Operation : std::uint8_t
+  {
+    ADD = 0, /**< add(key) */
+    CONTAINS = 1, /**< contains(key) */
+    REMOVE = 2, /**< remove(key) */
+    RANGE = 3, /**< aggregate(key, high) */
+    OPERATION_COUNT = 4 /**< Number of operation types */
+  };
+
+  // One operation of a workload.
+  struct Step
+  {
+    Operation operation; /**< Operation type */
+    unsigned int key; /**< Key (low bound for ranges) */
+    unsigned int high; /**< High bound (ranges only) */
+  };
+
+  // Workload configuration.
+  struct Config
+  {
+    std::string trace; /**< Trace file to replay (synthetic mix when empty) */
+    unsigned int threads = 1; /**< Worker threads (at most WORKLOAD_MAX_THREADS) */
+    std::size_t operations = 200000; /**< Synthetic operation count */
+    std::size_t preload = 100000; /**< Random keys added before the run */
+    unsigned int key_space = 1000000; /**< Keys are drawn from [0, key_space) */
+    unsigned int range_width = 100; /**< Width of synthetic ranges */
+    unsigned int add_percent = 20; /**< Synthetic share of adds (each share is at most 100) */
+    unsigned int contains_percent = 70; /**< Synthetic share of lookups */
+    unsigned int remove_percent = 5; /**< Synthetic share of removes */
+    unsigned int range_percent = 5; /**< Synthetic share of range queries */
+    unsigned int seed = 1; /**< Random seed */
+  };
+
+  // Operation name.
+  const char* name(Operation); /**< Returns the trace keyword of the operation. */
+
+  // Apply key=value setting.
+  void set(Config&, const std::string&); /**< Applies one key=value setting, range-checked for its field (throws std::invalid_argument). */
+
+  // Read configuration file.
+  void load_config(Config&, const std::string&); /**< Applies every key=value line of the file (throws on failure). */
+
+  // Read trace file.
+  std::vector< Step > load_trace(const std::string&); /**< Parses "add|contains|remove K" and "range LOW HIGH" lines (throws on failure). */
+
+  // Generate synthetic mix.
+  std::vector< Step > generate(const Config&); /**< Generates the configured random operation mix. */
+}
+//
+//  Terminating Precompiler Directives  ////////////////////////////////////////
+//
+#endif // WORKLOAD_H_
+//